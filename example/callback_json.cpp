@@ -4,10 +4,10 @@
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 //[ extended_callback_parsing_json_example
+#include <boost/parser/mapped_file.hpp>
 #include <boost/parser/parser.hpp>
 #include <boost/parser/transcode_view.hpp>
 
-#include <fstream>
 #include <vector>
 #include <climits>
 
@@ -153,32 +153,7 @@ namespace json {
 
     auto const string_def = bp::lexeme['"' >> *(string_char - '"') > '"'];
 
-    auto parse_double = [](auto & ctx) {
-        auto const cp_range = _attr(ctx);
-        auto cp_first = cp_range.begin();
-        auto const cp_last = cp_range.end();
-
-        auto const result = bp::prefix_parse(cp_first, cp_last, bp::double_);
-        if (result) {
-            _val(ctx) = *result;
-        } else {
-            // This would be more efficient if we used
-            // boost::container::small_vector, or std::inplace_vector from
-            // C++26.
-            std::vector<char> chars(cp_first, cp_last);
-            auto const chars_first = &*chars.begin();
-            auto chars_last = chars_first + chars.size();
-            _val(ctx) = std::strtod(chars_first, &chars_last);
-        }
-    };
-
-    auto const number_def =
-        bp::raw[bp::lexeme
-                    [-bp::char_('-') >>
-                     (bp::char_('1', '9') >> *bp::digit | bp::char_('0')) >>
-                     -(bp::char_('.') >> +bp::digit) >>
-                     -(bp::char_("eE") >> -bp::char_("+-") >> +bp::digit)]]
-               [parse_double];
+    auto const number_def = bp::json_number;
 
     // The object_element_key parser is exactly the same as the string parser.
     // Note that we did *not* use string here, though; we used string_def.  If
@@ -276,18 +251,6 @@ namespace json {
 
 }
 
-std::string file_slurp(std::ifstream & ifs)
-{
-    std::string retval;
-    while (ifs) {
-        char const c = ifs.get();
-        retval += c;
-    }
-    if (!retval.empty() && retval.back() == -1)
-        retval.pop_back();
-    return retval;
-}
-
 // This is our callbacks-struct.  It has a callback for each of the kinds of
 // callback rules in our parser.  If one were missing, you'd get a pretty
 // nasty template instantiation error.  Note that these are all const members;
@@ -355,14 +318,14 @@ int main(int argc, char * argv[])
         exit(1);
     }
 
-    std::ifstream ifs(argv[1]);
-    if (!ifs) {
+    std::error_code ec;
+    boost::parser::mapped_file const file(argv[1], ec);
+    if (ec) {
         std::cerr << "Unable to read file '" << argv[1] << "'.\n";
         exit(1);
     }
 
-    std::string const file_contents = file_slurp(ifs);
-    bool success = json::parse(file_contents, argv[1], json_callbacks{});
+    bool success = json::parse(file, argv[1], json_callbacks{});
     if (success) {
         std::cout << "Parse successful!\n";
     } else {
@@ -8,9 +8,9 @@
 // Javascript-like polymorphic value type.
 #include "json.hpp"
 
+#include <boost/parser/mapped_file.hpp>
 #include <boost/parser/parser.hpp>
 
-#include <fstream>
 #include <vector>
 #include <climits>
 
@@ -199,41 +199,13 @@ namespace json {
 
     auto const string_def = bp::lexeme['"' >> *(string_char - '"') > '"'];
 
-    // Since the JSON format for numbers is not exactly what
-    // boost::parser::double_ accepts (double_ accepts too much), we need to
-    // parse a JSON number as a sequence of characters, and then pass the
-    // result to double_ to actually get the numeric value.  This action does
-    // that.  The parser uses boost::parser::raw to produce the subrange of
-    // the input that covers the number as an attribute, which is used here.
-    auto parse_double = [](auto & ctx) {
-        auto const cp_range = _attr(ctx);
-        auto cp_first = cp_range.begin();
-        auto const cp_last = cp_range.end();
-
-        auto const result = bp::prefix_parse(cp_first, cp_last, bp::double_);
-        if (result) {
-            _val(ctx) = *result;
-        } else {
-            // This would be more efficient if we used
-            // boost::container::small_vector, or std::inplace_vector from
-            // C++26.
-            std::vector<char> chars(cp_first, cp_last);
-            auto const chars_first = &*chars.begin();
-            auto chars_last = chars_first + chars.size();
-            _val(ctx) = std::strtod(chars_first, &chars_last);
-        }
-    };
-
-    // As indicated above, we want to match the specific formats JSON allows,
-    // and then re-parse the resulting matched range within the semantic
-    // action.
-    auto const number_def =
-        bp::raw[bp::lexeme
-                    [-bp::char_('-') >>
-                     (bp::char_('1', '9') >> *bp::digit | bp::char_('0')) >>
-                     -(bp::char_('.') >> +bp::digit) >>
-                     -(bp::char_("eE") >> -bp::char_("+-") >> +bp::digit)]]
-               [parse_double];
+    // The JSON format for numbers is not exactly what
+    // boost::parser::double_ accepts (double_ accepts too much, like "+1",
+    // ".5", and "inf").  boost::parser::json_number matches exactly the
+    // numbers JSON allows, and produces the double value in the same pass
+    // over the input.  Like std::strtod(), it produces infinity for numbers
+    // too large for a double, such as 1e400.
+    auto const number_def = bp::json_number;
 
     // Note how, in the next three parsers, we turn off backtracking by using
     // > instead of >>, once we know that there is no backtracking alternative
@@ -323,18 +295,6 @@ namespace json {
 
 }
 
-std::string file_slurp(std::ifstream & ifs)
-{
-    std::string retval;
-    while (ifs) {
-        char const c = ifs.get();
-        retval += c;
-    }
-    if (!retval.empty() && retval.back() == -1)
-        retval.pop_back();
-    return retval;
-}
-
 int main(int argc, char * argv[])
 {
     if (argc < 2) {
@@ -342,17 +302,17 @@ int main(int argc, char * argv[])
         exit(1);
     }
 
-    std::ifstream ifs(argv[1]);
-    if (!ifs) {
+    // Map in the entire file.
+    std::error_code ec;
+    boost::parser::mapped_file const file(argv[1], ec);
+    if (ec) {
         std::cerr << "Unable to read file '" << argv[1] << "'.\n";
         exit(1);
     }
 
-    // Read in the entire file.
-    std::string const file_contents = file_slurp(ifs);
     // Parse the contents.  If there is an error, just stream it to cerr.
     auto json = json::parse(
-        file_contents, [](std::string const & msg) { std::cerr << msg; });
+        file, [](std::string const & msg) { std::cerr << msg; });
     if (!json) {
         std::cerr << "Parse failure.\n";
         exit(1);
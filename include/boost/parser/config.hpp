@@ -38,6 +38,23 @@
     throughout Boost.Parser. */
 #    define BOOST_PARSER_DISABLE_HANA_TUPLE
 
+/** Boost.Parser uses SSE2 or AVX2 instructions, when the compiler targets
+    them, to skip runs of whitespace when `ws` or `blank` is the skipper, and
+    to widen runs of ASCII in a `decoded_utf32`.  To disable the use of these
+    instructions, define this macro. */
+#    define BOOST_PARSER_DISABLE_SIMD
+
+/** Boost.Parser reports expectation failures by throwing `parse_error`,
+    unless the error handler accepts an `expectation_failure` (in which case
+    the failure is passed to the error handler directly, without throwing).
+    When this macro is defined, Boost.Parser uses no exceptions at all, and
+    every error handler is called without throwing.  An error handler that
+    only accepts `parse_error` is passed one that has not been thrown, and a
+    result of `error_handler_result::rethrow` is treated as
+    `error_handler_result::fail`.  This macro is defined automatically when
+    the compiler has exceptions turned off (e.g. with `-fno-exceptions`). */
+#    define BOOST_PARSER_NO_EXCEPTIONS
+
 /** Boost.Parser automatically treats aggregate structs as if they were
     tuples.  It uses some metaprogramming to do this.  The technique used has
     a hard limit on the number of data members a struct can have.  Re-define
@@ -81,6 +98,13 @@
 #    define BOOST_PARSER_SUBRANGE boost::parser::subrange
 #endif
 
+#if defined(BOOST_PARSER_NO_EXCEPTIONS) ||                                     \
+    !(defined(__cpp_exceptions) || defined(_CPPUNWIND))
+#    define BOOST_PARSER_USE_EXCEPTIONS 0
+#else
+#    define BOOST_PARSER_USE_EXCEPTIONS 1
+#endif
+
 #if defined(BOOST_PARSER_DISABLE_HANA_TUPLE)
 #    define BOOST_PARSER_USE_STD_TUPLE 1
 #else
@@ -0,0 +1,263 @@
+#ifndef BOOST_PARSER_DECODED_UTF32_HPP
+#define BOOST_PARSER_DECODED_UTF32_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+#include <boost/parser/detail/decode_utf.hpp>
+#include <boost/parser/detail/text/detail/algorithm.hpp>
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+
+namespace boost::parser {
+
+    namespace detail {
+        // A buffer of uninitialized code points.
+        struct utf32_buffer
+        {
+            std::unique_ptr<char32_t[]> data_;
+            std::size_t capacity_ = 0;
+        };
+
+        // Buffers larger than this (4MB) are freed when released, instead of
+        // being kept for the rest of the thread's life.
+        inline constexpr std::size_t max_cached_utf32_capacity =
+            (std::size_t(4) << 20) / sizeof(char32_t);
+
+        // The buffer most recently released on this thread, kept so that
+        // the next decoded_utf32 on this thread can reuse it.  This is
+        // trivially destructible, so that a decoded_utf32 with static
+        // storage duration can still use it when it is destroyed, which may
+        // be after the thread's thread_local objects have been destroyed.
+        // By then, closed_ is set, and nothing more is cached.
+        struct utf32_buffer_cache
+        {
+            char32_t * data_;
+            std::size_t capacity_;
+            bool closed_;
+        };
+
+        inline utf32_buffer_cache & cached_utf32_buffer()
+        {
+            thread_local utf32_buffer_cache retval{};
+            return retval;
+        }
+
+        // Frees the cached buffer when the thread's thread_local objects
+        // are destroyed.
+        struct utf32_buffer_cache_owner
+        {
+            ~utf32_buffer_cache_owner()
+            {
+                auto & cache = detail::cached_utf32_buffer();
+                delete[] cache.data_;
+                cache = utf32_buffer_cache{nullptr, 0, true};
+            }
+        };
+
+        inline utf32_buffer take_cached_utf32_buffer()
+        {
+            auto & cache = detail::cached_utf32_buffer();
+            utf32_buffer retval{
+                std::unique_ptr<char32_t[]>(cache.data_), cache.capacity_};
+            cache.data_ = nullptr;
+            cache.capacity_ = 0;
+            return retval;
+        }
+
+        // Keeps buf for reuse if it is larger than the cached buffer, and
+        // not too large to keep.  Otherwise, buf is left as it is.
+        inline void cache_utf32_buffer(utf32_buffer & buf)
+        {
+            auto & cache = detail::cached_utf32_buffer();
+            if (cache.closed_ || buf.capacity_ <= cache.capacity_ ||
+                max_cached_utf32_capacity < buf.capacity_) {
+                return;
+            }
+            thread_local utf32_buffer_cache_owner const owner;
+            (void)owner;
+            delete[] cache.data_;
+            cache.data_ = buf.data_.release();
+            cache.capacity_ = buf.capacity_;
+            buf.capacity_ = 0;
+        }
+
+        template<typename R>
+        auto decoded_utf32_first(R const & r)
+        {
+            if constexpr (std::is_pointer_v<R>)
+                return r;
+            else
+                return text::detail::begin(r);
+        }
+
+        template<typename R>
+        auto decoded_utf32_last(R const & r)
+        {
+            if constexpr (std::is_pointer_v<R>) {
+                auto last = r;
+                while (*last)
+                    ++last;
+                return last;
+            } else if constexpr (std::is_array_v<R>) {
+                // Like a string literal passed to parse(), leave out the
+                // null terminator.
+                auto last = text::detail::end(r);
+                if (std::begin(r) != last && !*std::prev(last))
+                    --last;
+                return last;
+            } else {
+                return text::detail::end(r);
+            }
+        }
+    }
+
+    /** A contiguous range of the code points in a UTF-8 or UTF-16 range,
+        decoded all at once when the `decoded_utf32` is constructed.
+
+        Passing a `decoded_utf32` to `parse()` or `prefix_parse()` (or to
+        `search()`) parses the `char32_t`s in its buffer with plain pointers.
+        That is usually much faster than parsing the original range, which
+        decodes each code point again every time the parse moves over it.
+        The decoding widens runs of ASCII (or, for UTF-16, of code units that
+        are not surrogates) without looking at them one at a time.  Ill-formed
+        UTF-8 is replaced with U+FFFD just as it is by `as_utf32`, and so is
+        each unpaired UTF-16 surrogate.
+
+        Positions in the buffer can be mapped back to positions in the
+        original range with `base()`.
+
+        The buffer is released to the current thread when the `decoded_utf32`
+        is destroyed, and the next `decoded_utf32` constructed on that thread
+        reuses it if it is large enough.  Buffers of more than 4MB are freed
+        instead.  The original range must outlive the
+        `decoded_utf32` only if `base()` is used. */
+#if BOOST_PARSER_USE_CONCEPTS
+    template<std::forward_iterator I, std::sentinel_for<I> S = I>
+#else
+    template<typename I, typename S = I>
+#endif
+    struct decoded_utf32
+    {
+        static_assert(
+            sizeof(*std::declval<I>()) == 1 || sizeof(*std::declval<I>()) == 2,
+            "decoded_utf32 decodes UTF-8 or UTF-16 code units only.");
+
+        using iterator = char32_t const *;
+
+        /** Decodes the code points in `[first, last)`. */
+        decoded_utf32(I first, S last) : first_(first), last_(last)
+        {
+            std::size_t const max_size = std::distance(first, last);
+            buf_ = detail::take_cached_utf32_buffer();
+            if (buf_.capacity_ < max_size) {
+                buf_.data_.reset(new char32_t[max_size]);
+                buf_.capacity_ = max_size;
+            }
+            if (!max_size)
+                return;
+            std::pair<std::size_t, std::size_t> sizes;
+            if constexpr (
+                detail::is_contiguous_iter_impl_v<I> && std::is_same_v<I, S>) {
+                auto const f = std::addressof(*first);
+                sizes = detail::decode_utf(f, f + max_size, buf_.data_.get());
+            } else {
+                sizes = detail::decode_utf(first, last, buf_.data_.get());
+            }
+            size_ = sizes.first;
+            one_unit_prefix_ = sizes.second;
+        }
+
+        /** Decodes the code points in `r`.  If `r` is a pointer, it is
+            treated as a null-terminated string; if it is an array, a null
+            terminator at its end is not decoded. */
+        template<typename R>
+        explicit decoded_utf32(R const & r) :
+            decoded_utf32(
+                detail::decoded_utf32_first(r), detail::decoded_utf32_last(r))
+        {}
+
+        decoded_utf32(decoded_utf32 && other) noexcept :
+            first_(other.first_),
+            last_(other.last_),
+            buf_(std::move(other.buf_)),
+            size_(other.size_),
+            one_unit_prefix_(other.one_unit_prefix_)
+        {
+            other.buf_.capacity_ = 0;
+            other.size_ = 0;
+            other.one_unit_prefix_ = 0;
+        }
+
+        decoded_utf32 & operator=(decoded_utf32 && other) noexcept
+        {
+            if (this != &other) {
+                release();
+                first_ = other.first_;
+                last_ = other.last_;
+                buf_ = std::move(other.buf_);
+                size_ = other.size_;
+                one_unit_prefix_ = other.one_unit_prefix_;
+                other.buf_.capacity_ = 0;
+                other.size_ = 0;
+                other.one_unit_prefix_ = 0;
+            }
+            return *this;
+        }
+
+        ~decoded_utf32() { release(); }
+
+        iterator begin() const { return buf_.data_.get(); }
+        iterator end() const { return buf_.data_.get() + size_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return !size_; }
+
+        /** Returns the position in the original range of the code point at
+            `it`, which must be in `[begin(), end()]`.  This is constant time
+            for positions before the first code point that took more than
+            one code unit, and linear in the distance from that code point
+            otherwise. */
+        I base(iterator it) const
+        {
+            std::size_t n = it - begin();
+            if (n <= one_unit_prefix_)
+                return std::next(first_, n);
+            I retval = std::next(first_, one_unit_prefix_);
+            for (n -= one_unit_prefix_; n; --n) {
+                detail::decode_code_point(retval, last_);
+            }
+            return retval;
+        }
+
+    private:
+        void release()
+        {
+            detail::cache_utf32_buffer(buf_);
+            buf_.data_.reset();
+            buf_.capacity_ = 0;
+        }
+
+        I first_;
+        S last_;
+        detail::utf32_buffer buf_;
+        std::size_t size_ = 0;
+        std::size_t one_unit_prefix_ = 0;
+    };
+
+    template<typename R>
+    decoded_utf32(R const & r) -> decoded_utf32<
+        decltype(detail::decoded_utf32_first(r)),
+        decltype(detail::decoded_utf32_last(r))>;
+
+    namespace detail {
+        template<typename T>
+        constexpr bool is_decoded_utf32_v = false;
+        template<typename I, typename S>
+        constexpr bool is_decoded_utf32_v<decoded_utf32<I, S>> = true;
+    }
+
+}
+
+#endif
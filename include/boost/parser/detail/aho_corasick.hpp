@@ -0,0 +1,223 @@
+#ifndef BOOST_PARSER_DETAIL_AHO_CORASICK_HPP
+#define BOOST_PARSER_DETAIL_AHO_CORASICK_HPP
+
+#include <boost/parser/config.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace boost::parser::detail {
+
+    /** An Aho-Corasick automaton over a set of char strings, used to find
+        where the first of any of them occurs in a sequence of chars, in a
+        single pass over the chars.
+
+        As in flat_trie, the nodes are stored in one array, in which the
+        children of each node are contiguous.  The nodes are created
+        breadth-first, so a node's failure link always refers to a node that
+        comes before it, and the nodes nearest the root come first.  Most of
+        the time is spent near the root, so the first nodes also get a full
+        row of transitions, in which failure links have already been
+        followed.  To keep the rows small, they are indexed by the class of
+        a char rather than by the char itself.  Each char that appears in
+        the strings has its own class, and all the others share class 0. */
+    struct aho_corasick
+    {
+        aho_corasick() : nodes_(1), keys_(1), dense_(1) {}
+
+        /** Builds the automaton from `strings`.  Empty strings are
+            ignored. */
+        explicit aho_corasick(std::vector<std::string> strings)
+        {
+            std::sort(strings.begin(), strings.end());
+            strings.erase(
+                std::unique(strings.begin(), strings.end()), strings.end());
+
+            // Each pending node covers the subrange of strings that share
+            // its prefix.  Pending nodes are handled first-in, first-out, so
+            // the nodes are created breadth-first.
+            struct pending_node
+            {
+                uint32_t index;
+                std::size_t first;
+                std::size_t last;
+            };
+            nodes_.push_back(node{});
+            keys_.push_back(0);
+            std::vector<pending_node> queue{{0, 0, strings.size()}};
+            for (std::size_t i = 0; i < queue.size(); ++i) {
+                pending_node const p = queue[i];
+                uint32_t const depth = nodes_[p.index].depth;
+                std::size_t first = p.first;
+                if (first != p.last && strings[first].size() == depth) {
+                    nodes_[p.index].match_size = depth;
+                    ++first;
+                }
+                nodes_[p.index].first_child = (uint32_t)nodes_.size();
+                while (first != p.last) {
+                    unsigned char const c = strings[first][depth];
+                    std::size_t last = first + 1;
+                    while (last != p.last &&
+                           (unsigned char)strings[last][depth] == c) {
+                        ++last;
+                    }
+                    node n;
+                    n.depth = depth + 1;
+                    nodes_.push_back(n);
+                    keys_.push_back(c);
+                    queue.push_back(
+                        pending_node{(uint32_t)nodes_.size() - 1, first, last});
+                    first = last;
+                }
+                nodes_[p.index].children =
+                    (uint32_t)nodes_.size() - nodes_[p.index].first_child;
+            }
+
+            // A node's failure link refers to the node for the longest
+            // proper suffix of its string that is also in the trie.  Its
+            // match_size becomes the size of the longest string that is a
+            // suffix of its string.
+            for (uint32_t i = 0; i < (uint32_t)nodes_.size(); ++i) {
+                node const & parent = nodes_[i];
+                for (uint32_t j = parent.first_child;
+                     j != parent.first_child + parent.children;
+                     ++j) {
+                    node & n = nodes_[j];
+                    n.fail = i == 0 ? 0 : sparse_next(parent.fail, keys_[j]);
+                    n.match_size =
+                        (std::max)(n.match_size, nodes_[n.fail].match_size);
+                }
+            }
+
+            unsigned char representatives[257] = {};
+            for (std::size_t i = 1; i < keys_.size(); ++i) {
+                unsigned char const c = keys_[i];
+                if (!classes_[c]) {
+                    classes_[c] = (uint16_t)classes_count_;
+                    representatives[classes_count_] = c;
+                    ++classes_count_;
+                }
+            }
+
+            // The rows cover the nodes up to depth 2, or fewer if that would
+            // take too much space.  Since a node's failure link refers to a
+            // node before it, the row of a node can be filled in from the
+            // row of its failure link.
+            std::size_t const max_dense_size = 1 << 18;
+            dense_nodes_ = 1;
+            while (dense_nodes_ < nodes_.size() &&
+                   nodes_[dense_nodes_].depth <= 2 &&
+                   (dense_nodes_ + 1) * classes_count_ <= max_dense_size) {
+                ++dense_nodes_;
+            }
+            dense_.resize(dense_nodes_ * classes_count_);
+            for (uint32_t i = 0; i < dense_nodes_; ++i) {
+                for (uint32_t k = 1; k < classes_count_; ++k) {
+                    uint32_t const child =
+                        find_child(nodes_[i], representatives[k]);
+                    dense_[i * classes_count_ + k] =
+                        child || i == 0
+                            ? child
+                            : dense_[nodes_[i].fail * classes_count_ + k];
+                }
+            }
+        }
+
+        /** Returns the first position in `[first, last)` at which one of the
+            strings begins, or `last`.  If several of the strings begin
+            there, which one is not reported. */
+        char const * find(char const * first, char const * last) const
+        {
+            char const * retval = last;
+            uint32_t n = 0;
+            for (char const * it = first; it != last; ++it) {
+                if (n == 0) {
+                    while (it != last && !dense_[classes_[(unsigned char)*it]]) {
+                        ++it;
+                    }
+                    if (it == last)
+                        break;
+                }
+                n = next(n, (unsigned char)*it);
+                node const & current = nodes_[n];
+                if (current.match_size) {
+                    char const * const match_first =
+                        it + 1 - current.match_size;
+                    if (match_first < retval)
+                        retval = match_first;
+                }
+                // The match found so far is the first one, once no partial
+                // match in progress begins before it.
+                if (retval != last &&
+                    current.depth <= std::size_t(it + 1 - retval)) {
+                    return retval;
+                }
+            }
+            return retval;
+        }
+
+    private:
+        struct node
+        {
+            uint32_t depth = 0;
+            uint32_t first_child = 0;
+            uint32_t children = 0;
+            uint32_t fail = 0;
+            uint32_t match_size = 0;
+        };
+
+        // Returns the node reached from node n on c, following failure links
+        // as needed.
+        uint32_t next(uint32_t n, unsigned char c) const
+        {
+            while (dense_nodes_ <= n) {
+                if (uint32_t const child = find_child(nodes_[n], c))
+                    return child;
+                n = nodes_[n].fail;
+            }
+            return dense_[n * classes_count_ + classes_[c]];
+        }
+
+        // The same as next(), for use before the rows are made.
+        uint32_t sparse_next(uint32_t n, unsigned char c) const
+        {
+            while (true) {
+                if (uint32_t const child = find_child(nodes_[n], c))
+                    return child;
+                if (n == 0)
+                    return 0;
+                n = nodes_[n].fail;
+            }
+        }
+
+        // Returns 0 if there is no such child, since the root is never a
+        // child.
+        uint32_t find_child(node const & n, unsigned char c) const
+        {
+            unsigned char const * const first = keys_.data() + n.first_child;
+            auto const it =
+                (unsigned char const *)std::memchr(first, c, n.children);
+            if (!it)
+                return 0;
+            return n.first_child + uint32_t(it - first);
+        }
+
+        std::vector<node> nodes_;
+        // The key of each node, kept apart from the nodes, so that finding
+        // a child only reads the keys of its siblings.
+        std::vector<unsigned char> keys_;
+        uint16_t classes_[256] = {};
+        uint32_t classes_count_ = 1;
+        // The rows of the first dense_nodes_ nodes, classes_count_ entries
+        // each.
+        std::vector<uint32_t> dense_;
+        uint32_t dense_nodes_ = 1;
+    };
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef BOOST_PARSER_DETAIL_ASCII_NO_CASE_HPP
+#define BOOST_PARSER_DETAIL_ASCII_NO_CASE_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+
+#if !defined(BOOST_PARSER_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#include <emmintrin.h>
+#define BOOST_PARSER_ASCII_NO_CASE_SSE2 1
+#endif
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace boost::parser::detail {
+
+    enum class ascii_no_case_result { match, mismatch, not_ascii };
+
+    /** Returns a word with `0x20` in each byte for which the corresponding
+        byte of `chars` is an ASCII letter, and `0` in the others.  Every
+        byte of `chars` must be ASCII. */
+    inline uint64_t ascii_letter_bits(uint64_t chars)
+    {
+        uint64_t const ones = 0x0101010101010101;
+        uint64_t const lower = chars | ones * 0x20;
+        // The high bit of each byte is set iff lower >= 'a', and iff
+        // lower > 'z', respectively.  Since every byte is at most 0x7f, no
+        // byte carries into the next.
+        uint64_t const at_least_a = lower + ones * (0x80 - 'a');
+        uint64_t const past_z = lower + ones * (0x80 - 'z' - 1);
+        return (at_least_a & ~past_z & ones * 0x80) >> 2;
+    }
+
+    /** Compares the `n` chars at `input` to the `n` ASCII chars at
+        `literal`, ignoring the case of letters, eight or sixteen at a time.
+        An ASCII char only case folds to an ASCII char, so this is the same
+        as comparing the case foldings of the two.  A non-ASCII char may
+        case fold to more than one code point (or, like U+212A KELVIN SIGN,
+        to an ASCII letter), so if one is seen before any mismatch, this
+        returns `not_ascii`, and the caller must compare the case foldings
+        itself. */
+    inline ascii_no_case_result ascii_no_case_compare(
+        char const * input, char const * literal, std::size_t n)
+    {
+        std::size_t i = 0;
+#if defined(BOOST_PARSER_ASCII_NO_CASE_SSE2)
+        for (; 16 <= n - i; i += 16) {
+            __m128i const chars =
+                _mm_loadu_si128((__m128i const *)(input + i));
+            if (_mm_movemask_epi8(chars))
+                return ascii_no_case_result::not_ascii;
+            __m128i const expected =
+                _mm_loadu_si128((__m128i const *)(literal + i));
+            __m128i const lower =
+                _mm_or_si128(expected, _mm_set1_epi8(0x20));
+            __m128i const letters = _mm_and_si128(
+                _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), lower));
+            __m128i const mask = _mm_and_si128(letters, _mm_set1_epi8(0x20));
+            __m128i const equal = _mm_cmpeq_epi8(
+                _mm_or_si128(chars, mask), _mm_or_si128(expected, mask));
+            if (_mm_movemask_epi8(equal) != 0xffff)
+                return ascii_no_case_result::mismatch;
+        }
+#endif
+        for (; 8 <= n - i; i += 8) {
+            uint64_t chars;
+            std::memcpy(&chars, input + i, 8);
+            if (chars & 0x8080808080808080)
+                return ascii_no_case_result::not_ascii;
+            uint64_t expected;
+            std::memcpy(&expected, literal + i, 8);
+            uint64_t const mask = detail::ascii_letter_bits(expected);
+            if ((chars | mask) != (expected | mask))
+                return ascii_no_case_result::mismatch;
+        }
+        for (; i < n; ++i) {
+            unsigned char const c = input[i];
+            if (0x80 <= c)
+                return ascii_no_case_result::not_ascii;
+            unsigned char const expected = literal[i];
+            unsigned char const lower = expected | 0x20;
+            unsigned char const mask = 'a' <= lower && lower <= 'z' ? 0x20 : 0;
+            if ((c | mask) != (expected | mask))
+                return ascii_no_case_result::mismatch;
+        }
+        return ascii_no_case_result::match;
+    }
+
+    /** Returns true iff `[first, last)` is a sequence of contiguous `char`s,
+        all of which are ASCII. */
+    template<typename Iter, typename Sentinel>
+    constexpr bool is_ascii_chars(Iter first, Sentinel last)
+    {
+        if constexpr (is_contiguous_char_iter_v<Iter>) {
+            for (; first != last; ++first) {
+                if (0x80 <= (unsigned char)*first)
+                    return false;
+            }
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+}
+
+#endif
@@ -5,105 +5,131 @@
 #include <boost/parser/detail/text/transcode_iterator.hpp>
 #include <boost/parser/detail/case_fold_data_generated.hpp>
 
-#include <algorithm>
+#include <array>
+#include <cstdint>
 
 
 namespace boost::parser::detail {
 
-    template<typename I>
-    std::optional<I> do_short_mapping(
-        short_mapping_range const * first,
-        short_mapping_range const * last,
-        char32_t cp,
-        I out)
+    // case_fold() looks up code points in a two-stage table, built at
+    // compile time from the generated mappings.  The first stage maps the
+    // high bits of a code point to a block of the second stage; the blocks
+    // that contain no case foldings all share block 0.  Each entry of the
+    // second stage is the difference between a code point and its
+    // single-code-point case folding, or, for a multi-code-point case
+    // folding, case_fold_long_entry plus the index of its long_mapping.
+    inline constexpr int case_fold_block_bits = 8;
+    inline constexpr int case_fold_block_size = 1 << case_fold_block_bits;
+    inline constexpr int case_fold_blocks = 0x110000 >> case_fold_block_bits;
+    inline constexpr int32_t case_fold_long_entry = 0x200000;
+
+    constexpr std::array<bool, case_fold_blocks> case_fold_used_blocks()
+    {
+        std::array<bool, case_fold_blocks> retval{};
+        for (auto const & range : mapping_ranges) {
+            for (char32_t cp = range.cp_first_; cp < range.cp_last_;
+                 cp += range.stride_) {
+                retval[cp >> case_fold_block_bits] = true;
+            }
+        }
+        for (auto const & mapping : long_mappings) {
+            retval[mapping.cp_ >> case_fold_block_bits] = true;
+        }
+        return retval;
+    }
+
+    constexpr int case_fold_stage_2_blocks()
     {
-        auto it = std::lower_bound(
-            first,
-            last,
-            cp,
-            [](short_mapping_range const & range, char32_t cp) {
-                return range.cp_first_ < cp;
-            });
-        if (it != first) {
-            auto const prev = it - 1;
-            if (prev->cp_first_ <= cp && cp < prev->cp_last_)
-                it = prev;
+        int retval = 1;
+        for (bool used : case_fold_used_blocks()) {
+            retval += used;
         }
-        if (it != last && it->cp_first_ <= cp && cp < it->cp_last_) {
-            auto const offset = cp - it->cp_first_;
-            if (offset % it->stride_ == 0) {
-                *out++ =
-                    single_mapping_cps[it->first_idx_ + offset / it->stride_];
-                return out;
+        return retval;
+    }
+
+    struct case_fold_table_t
+    {
+        std::array<uint8_t, case_fold_blocks> stage_1_;
+        std::array<int32_t, case_fold_stage_2_blocks() * case_fold_block_size>
+            stage_2_;
+    };
+
+    static_assert(case_fold_stage_2_blocks() <= 0x100);
+
+    constexpr case_fold_table_t make_case_fold_table()
+    {
+        case_fold_table_t retval{};
+        auto const used = case_fold_used_blocks();
+        uint8_t next_block = 1;
+        for (int i = 0; i < case_fold_blocks; ++i) {
+            if (used[i])
+                retval.stage_1_[i] = next_block++;
+        }
+        auto const entry = [&retval](char32_t cp) -> int32_t & {
+            return retval.stage_2_
+                [retval.stage_1_[cp >> case_fold_block_bits] *
+                     case_fold_block_size +
+                 (cp & (case_fold_block_size - 1))];
+        };
+        int32_t long_index = 0;
+        for (auto const & mapping : long_mappings) {
+            entry(mapping.cp_) = case_fold_long_entry + long_index++;
+        }
+        // Single-code-point case foldings take precedence.
+        for (auto const & range : mapping_ranges) {
+            int idx = range.first_idx_;
+            for (char32_t cp = range.cp_first_; cp < range.cp_last_;
+                 cp += range.stride_) {
+                entry(cp) = int32_t(single_mapping_cps[idx++]) - int32_t(cp);
             }
         }
+        return retval;
+    }
+
+    inline constexpr case_fold_table_t case_fold_table =
+        make_case_fold_table();
 
-        return std::nullopt;
+    /** Returns the case folding of cp, which must be less than 0x100 and
+        not U+00DF, the one code point in that range with a multi-code-point
+        case folding.  Unlike case_fold(), this can be used at compile
+        time. */
+    constexpr char32_t latin1_case_fold(char32_t cp)
+    {
+        if ((0x41 <= cp && cp <= 0x5a) ||
+            (0xc0 <= cp && cp <= 0xde && cp != 0xd7)) {
+            return cp + 0x20;
+        }
+        if (cp == 0xb5)
+            return 0x03bc;
+        return cp;
     }
 
     template<typename I>
     I case_fold(char32_t cp, I out)
     {
-        // One-byte fast path.
-        if (cp < 0x100) {
-            // ASCII letter fast path.
-            if (0x41 <= cp && cp < 0x5a) {
-                *out++ = cp + 0x20;
-                return out;
-            } else if (cp == 0x00DF) {
-                // The lone multi-mapping below 0x100.
-                *out++ = 0x0073;
-                *out++ = 0x0073;
-                return out;
-            } else {
-                // Skip [0x41, 0x5a), handled above.
-                auto const first =
-                    detail::text::detail::begin(mapping_ranges) + 1;
-                // 7th entry starts with 0x100.
-                auto const last =
-                    detail::text::detail::begin(mapping_ranges) + 7;
-                if (auto out_opt = do_short_mapping(first, last, cp, out))
-                    return *out_opt;
-            }
+        // ASCII fast path.
+        if (cp < 0x80) {
+            *out++ = 0x41 <= cp && cp <= 0x5a ? cp + 0x20 : cp;
+            return out;
+        }
+        if (0x110000 <= cp) {
             *out++ = cp;
             return out;
         }
 
-        // Single-cp-mapping path (next most common case).
-        {
-            auto const first = detail::text::detail::begin(mapping_ranges);
-            auto const last = detail::text::detail::end(mapping_ranges);
-            if (auto out_opt = do_short_mapping(first, last, cp, out))
-                return *out_opt;
+        int32_t const entry = case_fold_table.stage_2_
+            [case_fold_table.stage_1_[cp >> case_fold_block_bits] *
+                 case_fold_block_size +
+             (cp & (case_fold_block_size - 1))];
+        if (entry < case_fold_long_entry) {
+            *out++ = char32_t(cp + entry);
+            return out;
         }
 
-        // Multi-cp mapping path.
-        {
-            auto const last = detail::text::detail::end(long_mappings);
-            auto const it = std::lower_bound(
-                detail::text::detail::begin(long_mappings),
-                last,
-                cp,
-                [](long_mapping const & mapping, char32_t cp) {
-                    return mapping.cp_ < cp;
-                });
-            if (it != last && it->cp_ == cp) {
-#if BOOST_PARSER_USE_CONCEPTS
-                return std::ranges::copy(it->mapping_, text::null_sentinel, out)
-                    .out;
-#else
-                return std::copy(
-                    it->mapping_,
-                    std::find(
-                        detail::text::detail::begin(it->mapping_),
-                        detail::text::detail::end(it->mapping_),
-                        0),
-                    out);
-#endif
-            }
+        auto const & mapping = long_mappings[entry - case_fold_long_entry];
+        for (int i = 0; i < longest_mapping && mapping.mapping_[i]; ++i) {
+            *out++ = mapping.mapping_[i];
         }
-
-        *out++ = cp;
         return out;
     }
 
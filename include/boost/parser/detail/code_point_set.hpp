@@ -0,0 +1,111 @@
+#ifndef BOOST_PARSER_DETAIL_CODE_POINT_SET_HPP
+#define BOOST_PARSER_DETAIL_CODE_POINT_SET_HPP
+
+#include <boost/parser/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace boost::parser::detail {
+
+    /** A set of the code points in [0, 0x100), one bit each. */
+    struct latin1_bitmap
+    {
+        constexpr void add(uint32_t c)
+        {
+            bits_[c >> 6] |= uint64_t(1) << (c & 63);
+        }
+
+        /** Returns true if c is in the set.  c must be less than 0x100. */
+        constexpr bool contains(uint32_t c) const
+        {
+            return (bits_[c >> 6] >> (c & 63)) & 1;
+        }
+
+        uint64_t bits_[4] = {};
+    };
+
+    /** A set of code points that can be tested for membership with a bit
+        test or two.  The Latin-1 code points are kept in their own bitmap.
+        The rest are split into blocks of 0x100 code points; the first stage
+        gives the index of the bitmap of each block in the second stage.
+        Blocks with nothing in them share the empty bitmap at index 0. */
+    template<std::size_t Stage1Size, std::size_t Blocks>
+    struct code_point_table
+    {
+        static_assert(Blocks <= 0x100);
+
+        constexpr bool contains(uint32_t c) const
+        {
+            if (c < 0x100)
+                return latin1_.contains(c);
+            uint32_t const block = c >> 8;
+            if (Stage1Size <= block)
+                return false;
+            return blocks_[stage1_[block]].contains(c & 0xff);
+        }
+
+        latin1_bitmap latin1_;
+        uint8_t stage1_[Stage1Size] = {};
+        latin1_bitmap blocks_[Blocks];
+    };
+
+    /** Returns the size of the first stage of a code_point_table for the
+        code points in `[first, last)`. */
+    constexpr std::size_t
+    code_point_table_stage1_size(uint32_t const * first, uint32_t const * last)
+    {
+        std::size_t retval = 1;
+        for (; first != last; ++first) {
+            if (retval <= (*first >> 8))
+                retval = (*first >> 8) + 1;
+        }
+        return retval;
+    }
+
+    /** Returns the number of bitmaps in the second stage of a
+        code_point_table for the code points in `[first, last)`, counting
+        the empty one. */
+    constexpr std::size_t
+    code_point_table_blocks(uint32_t const * first, uint32_t const * last)
+    {
+        bool seen[0x1100] = {};
+        std::size_t retval = 1;
+        for (; first != last; ++first) {
+            uint32_t const block = *first >> 8;
+            if (block == 0 || 0x1100 <= block || seen[block])
+                continue;
+            seen[block] = true;
+            ++retval;
+        }
+        return retval;
+    }
+
+    /** Returns a code_point_table containing the code points in `[first,
+        last)`, which need not be sorted.  The sizes must be the ones
+        computed by code_point_table_stage1_size() and
+        code_point_table_blocks(). */
+    template<std::size_t Stage1Size, std::size_t Blocks>
+    constexpr code_point_table<Stage1Size, Blocks>
+    make_code_point_table(uint32_t const * first, uint32_t const * last)
+    {
+        code_point_table<Stage1Size, Blocks> retval;
+        std::size_t next_block = 1;
+        for (; first != last; ++first) {
+            uint32_t const c = *first;
+            if (c < 0x100) {
+                retval.latin1_.add(c);
+                continue;
+            }
+            uint32_t const block = c >> 8;
+            if (!retval.stage1_[block])
+                retval.stage1_[block] = uint8_t(next_block++);
+            retval.blocks_[retval.stage1_[block]].add(c & 0xff);
+        }
+        return retval;
+    }
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_PARSER_DETAIL_CONTIGUOUS_HPP
+#define BOOST_PARSER_DETAIL_CONTIGUOUS_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/text/transcode_iterator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace boost::parser::detail {
+
+    template<typename Iter>
+    constexpr bool is_contiguous_iter_impl_v =
+#if BOOST_PARSER_USE_CONCEPTS
+        std::contiguous_iterator<Iter> ||
+#endif
+        std::is_pointer_v<Iter> ||
+        std::is_same_v<Iter, std::string::iterator> ||
+        std::is_same_v<Iter, std::string::const_iterator> ||
+        std::is_same_v<Iter, std::vector<char>::iterator> ||
+        std::is_same_v<Iter, std::vector<char>::const_iterator>;
+
+    template<typename Iter>
+    using iter_element_t = std::remove_cv_t<
+        std::remove_reference_t<decltype(*std::declval<Iter &>())>>;
+
+    /** True iff `Iter` is an iterator over contiguous `char`s, such as
+        `char const *` or `std::string::const_iterator`.  Parsers use this to
+        select code paths that work directly on the underlying memory. */
+    template<typename Iter>
+    constexpr bool is_contiguous_char_iter_v =
+        std::is_same_v<iter_element_t<Iter>, char> &&
+        is_contiguous_iter_impl_v<Iter>;
+
+    /** Returns a pointer to the element `it` refers to.  `it` must be
+        dereferenceable. */
+    template<typename Iter>
+    char const * to_char_pointer(Iter it) noexcept
+    {
+        static_assert(is_contiguous_char_iter_v<Iter>);
+        return std::addressof(*it);
+    }
+
+    template<typename Iter>
+    constexpr bool is_random_access_iter_v = std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iter>::iterator_category>;
+
+    /** True iff the offset of one `Iter` from another can be found in
+        constant time, because `Iter` is random access, or is a transcoding
+        iterator over such an iterator.  See `iter_position()`. */
+    template<typename Iter, bool = text::detail::is_utf_iter<Iter>>
+    constexpr bool has_iter_position_v = is_random_access_iter_v<Iter>;
+    template<typename Iter>
+    constexpr bool has_iter_position_v<Iter, true> =
+        has_iter_position_v<decltype(std::declval<Iter>().base())>;
+
+    /** Returns the offset of `it` from `first`, in the underlying code units
+        when `Iter` is a transcoding iterator. */
+    template<typename Iter>
+    std::ptrdiff_t iter_position(Iter first, Iter it)
+    {
+        if constexpr (is_random_access_iter_v<Iter>)
+            return it - first;
+        else
+            return detail::iter_position(first.base(), it.base());
+    }
+
+    /** Returns a `std::string_view` of the `char`s in `[first, last)`. */
+    template<typename Iter>
+    std::string_view to_string_view(Iter first, Iter last) noexcept
+    {
+        if (first == last)
+            return {};
+        return {detail::to_char_pointer(first), std::size_t(last - first)};
+    }
+
+    /** Returns the number of `char`s in `[first, last)`, if `Iter` is an
+        iterator over contiguous `char`s, or `-1` otherwise. */
+    template<typename Iter, typename Sentinel>
+    constexpr std::ptrdiff_t contiguous_char_size(Iter first, Sentinel last)
+    {
+        if constexpr (!is_contiguous_char_iter_v<Iter>) {
+            return -1;
+        } else if constexpr (std::is_same_v<Iter, Sentinel>) {
+            return last - first;
+        } else {
+            std::ptrdiff_t retval = 0;
+            for (; first != last; ++first) {
+                ++retval;
+            }
+            return retval;
+        }
+    }
+
+}
+
+#endif
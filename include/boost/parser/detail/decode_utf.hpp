@@ -0,0 +1,201 @@
+#ifndef BOOST_PARSER_DETAIL_DECODE_UTF_HPP
+#define BOOST_PARSER_DETAIL_DECODE_UTF_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/text/transcode_iterator.hpp>
+
+#if !defined(BOOST_PARSER_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOOST_PARSER_DECODE_UTF_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#include <emmintrin.h>
+#define BOOST_PARSER_DECODE_UTF_SSE2 1
+#endif
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost::parser::detail {
+
+    /** Writes the code points of the ASCII chars at the start of `[first,
+        last)` to `out`, stopping at the first non-ASCII char.  Returns the
+        number of chars written.  Where SSE2 or AVX2 is available, the chars
+        are widened 16 at a time. */
+    template<typename CharType>
+    std::size_t
+    widen_ascii(CharType const * first, CharType const * last, char32_t * out)
+    {
+        static_assert(sizeof(CharType) == 1);
+        CharType const * const initial = first;
+#if defined(BOOST_PARSER_DECODE_UTF_AVX2) ||                                   \
+    defined(BOOST_PARSER_DECODE_UTF_SSE2)
+        while (16 <= last - first) {
+            __m128i const chars = _mm_loadu_si128((__m128i const *)first);
+            if (_mm_movemask_epi8(chars))
+                break;
+#if defined(BOOST_PARSER_DECODE_UTF_AVX2)
+            _mm256_storeu_si256(
+                (__m256i *)out, _mm256_cvtepu8_epi32(chars));
+            _mm256_storeu_si256(
+                (__m256i *)(out + 8),
+                _mm256_cvtepu8_epi32(_mm_srli_si128(chars, 8)));
+#else
+            __m128i const zero = _mm_setzero_si128();
+            __m128i const lo = _mm_unpacklo_epi8(chars, zero);
+            __m128i const hi = _mm_unpackhi_epi8(chars, zero);
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(
+                (__m128i *)(out + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(
+                (__m128i *)(out + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(
+                (__m128i *)(out + 12), _mm_unpackhi_epi16(hi, zero));
+#endif
+            first += 16;
+            out += 16;
+        }
+#endif
+        for (; first != last; ++first, ++out) {
+            unsigned char const c = *first;
+            if (0x80 <= c)
+                break;
+            *out = c;
+        }
+        return first - initial;
+    }
+
+    /** Writes the code points of the UTF-16 code units at the start of
+        `[first, last)` that are not surrogates to `out`, stopping at the
+        first surrogate.  Returns the number of code units written.  Where
+        SSE2 or AVX2 is available, the code units are widened 8 at a time. */
+    template<typename CharType>
+    std::size_t
+    widen_bmp(CharType const * first, CharType const * last, char32_t * out)
+    {
+        static_assert(sizeof(CharType) == 2);
+        CharType const * const initial = first;
+#if defined(BOOST_PARSER_DECODE_UTF_AVX2) ||                                   \
+    defined(BOOST_PARSER_DECODE_UTF_SSE2)
+        __m128i const surrogate_mask = _mm_set1_epi16((short)0xf800);
+        __m128i const surrogates = _mm_set1_epi16((short)0xd800);
+        while (8 <= last - first) {
+            __m128i const units = _mm_loadu_si128((__m128i const *)first);
+            __m128i const is_surrogate = _mm_cmpeq_epi16(
+                _mm_and_si128(units, surrogate_mask), surrogates);
+            if (_mm_movemask_epi8(is_surrogate))
+                break;
+#if defined(BOOST_PARSER_DECODE_UTF_AVX2)
+            _mm256_storeu_si256((__m256i *)out, _mm256_cvtepu16_epi32(units));
+#else
+            __m128i const zero = _mm_setzero_si128();
+            _mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi16(units, zero));
+            _mm_storeu_si128(
+                (__m128i *)(out + 4), _mm_unpackhi_epi16(units, zero));
+#endif
+            first += 8;
+            out += 8;
+        }
+#endif
+        for (; first != last; ++first, ++out) {
+            char16_t const c = *first;
+            if (text::surrogate(c))
+                break;
+            *out = c;
+        }
+        return first - initial;
+    }
+
+    /** Decodes the code point at `first`, a position in UTF-16 code units,
+        and advances `first` past it.  Like the transcoding views, this
+        produces U+FFFD for each unpaired surrogate. */
+    template<typename Iter, typename Sentinel>
+    char32_t decode_utf16_code_point(Iter & first, Sentinel last)
+    {
+        char32_t const hi = (char16_t)*first;
+        ++first;
+        if (!text::surrogate(hi))
+            return hi;
+        if (text::high_surrogate(hi) && first != last) {
+            char32_t const lo = (char16_t)*first;
+            if (text::low_surrogate(lo)) {
+                ++first;
+                return ((hi - 0xd800) << 10) + (lo - 0xdc00) + 0x10000;
+            }
+        }
+        return text::replacement_character;
+    }
+
+    /** Decodes the code point at `first` in UTF-8 or UTF-16 code units, and
+        advances `first` past it.  Ill-formed UTF-8 produces U+FFFD exactly
+        where `as_utf32` would produce it. */
+    template<typename Iter, typename Sentinel>
+    char32_t decode_code_point(Iter & first, Sentinel last)
+    {
+        if constexpr (sizeof(*first) == 1) {
+            unsigned char const c = *first;
+            if (c < 0x80) {
+                ++first;
+                return c;
+            }
+            return text::detail::advance(first, last);
+        } else {
+            return detail::decode_utf16_code_point(first, last);
+        }
+    }
+
+    /** Writes the code points of the UTF-8 or UTF-16 code units in `[first,
+        last)` to `out`, which must have room for one code point per code
+        unit.  Returns a pair: the number of code points written, and the
+        number of them written before the first code point that took more
+        than one code unit.  Runs of ASCII (or, for UTF-16, of
+        non-surrogates) are widened without being decoded, using SIMD
+        instructions where available. */
+    template<typename Iter, typename Sentinel>
+    std::pair<std::size_t, std::size_t>
+    decode_utf(Iter first, Sentinel last, char32_t * out)
+    {
+        char32_t * const initial = out;
+        std::size_t one_unit_prefix = 0;
+        bool in_prefix = true;
+        if constexpr (
+            std::is_pointer_v<Iter> && std::is_same_v<Iter, Sentinel>) {
+            while (first != last) {
+                std::size_t n = 0;
+                if constexpr (sizeof(*first) == 1)
+                    n = detail::widen_ascii(first, last, out);
+                else
+                    n = detail::widen_bmp(first, last, out);
+                first += n;
+                out += n;
+                if (first == last)
+                    break;
+                if (in_prefix) {
+                    one_unit_prefix = out - initial;
+                    in_prefix = false;
+                }
+                *out++ = detail::decode_code_point(first, last);
+            }
+        } else {
+            for (; first != last; ++out) {
+                Iter const prev = first;
+                *out = detail::decode_code_point(first, last);
+                if (in_prefix && std::next(prev) != first) {
+                    one_unit_prefix = out - initial;
+                    in_prefix = false;
+                }
+            }
+        }
+        std::size_t const size = out - initial;
+        return {size, in_prefix ? size : one_unit_prefix};
+    }
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_PARSER_DETAIL_FAST_INT_HPP
+#define BOOST_PARSER_DETAIL_FAST_INT_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+#include <boost/parser/detail/debug_assert.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+namespace boost::parser::detail {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    inline constexpr bool swar_digits =
+        __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    inline constexpr bool swar_digits = true;
+#else
+    inline constexpr bool swar_digits = false;
+#endif
+
+    inline int swar_countr_zero(uint64_t x)
+    {
+        BOOST_PARSER_DEBUG_ASSERT(x);
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long retval;
+        _BitScanForward64(&retval, x);
+        return (int)retval;
+#else
+        int retval = 0;
+        for (; !(x & 1u); x >>= 1) {
+            ++retval;
+        }
+        return retval;
+#endif
+    }
+
+    // Returns a word with a nonzero byte for each byte of `x` that is not an
+    // ASCII digit.  A byte that is not a digit may make the bytes after it
+    // (in memory order) nonzero too, which is fine, since only the first
+    // non-digit matters.
+    inline uint64_t swar_nondigits(uint64_t x)
+    {
+        uint64_t const high_nibbles = 0xf0f0f0f0f0f0f0f0ull;
+        uint64_t const threes = 0x3030303030303030ull;
+        return ((x & high_nibbles) ^ threes) |
+               (((x + 0x0606060606060606ull) & high_nibbles) ^ threes);
+    }
+
+    // Converts the eight digits in `x` to their value.  `x` holds the
+    // digits' values (not their characters), with the first one in its low
+    // byte.
+    inline uint64_t swar_value8(uint64_t x)
+    {
+        x = (x * 10) + (x >> 8);
+        x = (((x & 0x000000ff000000ffull) * (100 + (1000000ull << 32))) +
+             (((x >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >>
+            32;
+        return x;
+    }
+
+    inline constexpr uint64_t pow10_u64[] = {
+        1ull,
+        10ull,
+        100ull,
+        1000ull,
+        10000ull,
+        100000ull,
+        1000000ull,
+        10000000ull,
+        100000000ull};
+
+    /** Parses a decimal integer from the `char`s in `[first, last)`, with the
+        same syntax and results as `detail_spirit_x3::extract_int` (for signed
+        `T`) or `detail_spirit_x3::extract_uint` (for unsigned `T`) with a
+        radix of 10.  Digits are recognized and converted eight at a time.
+        Numbers long enough that they might overflow `T` are handed to
+        `Extract::call()`. */
+    template<typename Extract, typename T>
+    bool parse_int_chars(char const *& first, char const * last, T & attr)
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+        constexpr int safe_digits = std::numeric_limits<T>::digits10;
+
+        char const * it = first;
+        bool neg = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (it != last && (*it == '-' || *it == '+')) {
+                neg = *it == '-';
+                ++it;
+            }
+        }
+        char const * const digits_first = it;
+        while (it != last && *it == '0') {
+            ++it;
+        }
+        bool const leading_zeros = it != digits_first;
+
+        uint64_t value = 0;
+        int digits = 0;
+        bool at_end_of_digits = false;
+        if constexpr (swar_digits) {
+            while (!at_end_of_digits && 8 <= last - it) {
+                uint64_t x;
+                std::memcpy(&x, it, 8);
+                uint64_t const nondigits = swar_nondigits(x);
+                x -= 0x3030303030303030ull;
+                if (!nondigits) {
+                    value = value * pow10_u64[8] + swar_value8(x);
+                    it += 8;
+                    digits += 8;
+                    if (safe_digits < digits)
+                        return Extract::call(first, last, attr);
+                    continue;
+                }
+                int const n = swar_countr_zero(nondigits) / 8;
+                if (n) {
+                    value = value * pow10_u64[n] +
+                            swar_value8(x << (8 * (8 - n)));
+                    it += n;
+                    digits += n;
+                }
+                at_end_of_digits = true;
+            }
+        }
+        if (!at_end_of_digits) {
+            for (; it != last && '0' <= *it && *it <= '9'; ++it) {
+                value = value * 10 + unsigned(*it - '0');
+                ++digits;
+            }
+        }
+        if (safe_digits < digits)
+            return Extract::call(first, last, attr);
+        if (!digits && !leading_zeros)
+            return false;
+
+        if constexpr (std::is_signed_v<T>)
+            attr = neg ? T(-T(value)) : T(value);
+        else
+            attr = T(value);
+        first = it;
+        return true;
+    }
+
+    /** True iff `parse_int_fast()` can be used to parse a `T` with the given
+        radix and digit limits, from `[Iter, Sentinel)`. */
+    template<
+        typename T,
+        int Radix,
+        int MinDigits,
+        int MaxDigits,
+        typename Iter,
+        typename Sentinel>
+    constexpr bool use_parse_int_fast_v =
+        Radix == 10 && MinDigits == 1 && MaxDigits == -1 &&
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        sizeof(T) <= sizeof(uint64_t) && is_contiguous_char_iter_v<Iter> &&
+        std::is_same_v<Iter, Sentinel>;
+
+    /** Calls `parse_int_chars()` on the memory underlying `[first, last)`. */
+    template<typename Extract, typename T, typename Iter>
+    bool parse_int_fast(Iter & first, Iter last, T & attr)
+    {
+        if (first == last)
+            return false;
+        char const * const chars_first = detail::to_char_pointer(first);
+        char const * it = chars_first;
+        bool const retval = detail::parse_int_chars<Extract>(
+            it, chars_first + (last - first), attr);
+        first += it - chars_first;
+        return retval;
+    }
+
+}
+
+#endif
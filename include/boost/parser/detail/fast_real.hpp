@@ -0,0 +1,325 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_PARSER_DETAIL_FAST_REAL_HPP
+#define BOOST_PARSER_DETAIL_FAST_REAL_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+#include <boost/parser/detail/numeric.hpp>
+
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+
+namespace boost::parser::detail {
+
+    // The characters of a number, copied out of an input that std::from_chars()
+    // cannot read directly.  Numbers that do not fit in the local buffer go
+    // in the heap.
+    struct real_chars
+    {
+        void push_back(char c)
+        {
+            if (size_ < (int)sizeof(local_)) {
+                local_[size_++] = c;
+                return;
+            }
+            if (heap_.empty())
+                heap_.assign(local_, size_);
+            heap_.push_back(c);
+            ++size_;
+        }
+        char const * begin() const
+        {
+            return heap_.empty() ? local_ : heap_.data();
+        }
+        char const * end() const { return begin() + size_; }
+
+    private:
+        char local_[128];
+        int size_ = 0;
+        std::string heap_;
+    };
+
+    template<typename T>
+    bool is_digit(T c)
+    {
+        return T('0') <= c && c <= T('9');
+    }
+
+    // Converts [first, last), which must be a valid number in the format
+    // accepted by std::chars_format::general, without a leading sign.  A
+    // result too large for T is infinity if InfOnOverflow is true; otherwise
+    // false is returned.  A result too small for T is 0.
+    template<bool InfOnOverflow, typename T>
+    bool convert_real_chars(
+        char const * first, char const * last, bool tiny, T & attr)
+    {
+#if defined(__cpp_lib_to_chars)
+        auto const result = std::from_chars(first, last, attr);
+        BOOST_PARSER_DEBUG_ASSERT(result.ptr == last);
+        if (result.ec == std::errc::result_out_of_range) {
+            if (tiny)
+                attr = 0;
+            else if (InfOnOverflow)
+                attr = std::numeric_limits<T>::infinity();
+            else
+                return false;
+        }
+        return true;
+#else
+        detail_spirit_x3::real_policies<T> policies;
+        using extract = detail_spirit_x3::
+            extract_real<T, detail_spirit_x3::real_policies<T>>;
+        if (extract::parse(first, last, attr, policies))
+            return true;
+        if (!InfOnOverflow || tiny)
+            return false;
+        attr = std::numeric_limits<T>::infinity();
+        return true;
+#endif
+    }
+
+    template<typename T>
+    constexpr bool exact_fast_path_v =
+        (std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+        std::numeric_limits<T>::is_iec559 && FLT_EVAL_METHOD == 0;
+
+    // The powers of ten that are exactly representable as a double.
+    inline constexpr double exact_pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    // Computes mantissa * 10^exp10 exactly, if both mantissa and 10^|exp10|
+    // are exactly representable in T.  Then a single multiplication or
+    // division, which IEEE 754 rounds correctly, gives the correctly rounded
+    // result.  This is Clinger's fast path, and it covers most of the numbers
+    // found in practice.
+    template<typename T>
+    bool exact_real(uint64_t mantissa, int exp10, T & attr)
+    {
+        constexpr int max_exp10 = std::is_same_v<T, float> ? 10 : 22;
+        constexpr uint64_t max_mantissa = uint64_t(1)
+                                          << std::numeric_limits<T>::digits;
+        if (max_mantissa < mantissa || exp10 < -max_exp10 ||
+            max_exp10 < exp10) {
+            return false;
+        }
+        T const pow10 = T(exact_pow10[exp10 < 0 ? -exp10 : exp10]);
+        attr = exp10 < 0 ? T(mantissa) / pow10 : T(mantissa) * pow10;
+        return true;
+    }
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(_WIN32)
+    // x87 long double has a 64-bit significand, and (outside Windows) is
+    // used at full precision by default.
+    inline constexpr bool extended_fast_path =
+        std::numeric_limits<long double>::digits == 64;
+#else
+    inline constexpr bool extended_fast_path = false;
+#endif
+
+    // 10^0 through 10^63, each correctly rounded to a long double.
+    inline constexpr long double extended_pow10[] = {
+        1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+        1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+        1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L, 1e28L, 1e29L,
+        1e30L, 1e31L, 1e32L, 1e33L, 1e34L, 1e35L, 1e36L, 1e37L, 1e38L, 1e39L,
+        1e40L, 1e41L, 1e42L, 1e43L, 1e44L, 1e45L, 1e46L, 1e47L, 1e48L, 1e49L,
+        1e50L, 1e51L, 1e52L, 1e53L, 1e54L, 1e55L, 1e56L, 1e57L, 1e58L, 1e59L,
+        1e60L, 1e61L, 1e62L, 1e63L};
+
+    // Computes mantissa * 10^exp10 in long double, where it has 11 (for
+    // double) or 40 (for float) more bits of significand than T.  The
+    // mantissa is exact, and the power of ten and the multiplication or
+    // division are each rounded once, so the result is within 2 units in
+    // the last place of the long double.  Rounding that to T gives the
+    // correctly rounded result unless the bits that are dropped are within
+    // that distance of half a unit in the last place of T; those cases are
+    // left to the caller.  This covers the numbers with exponents too large
+    // for exact_real().
+    template<typename T>
+    bool extended_real(uint64_t mantissa, int exp10, T & attr)
+    {
+        constexpr int max_exp10 = std::size(extended_pow10) - 1;
+        if (!mantissa || exp10 < -max_exp10 || max_exp10 < exp10)
+            return false;
+        long double const pow10 = extended_pow10[exp10 < 0 ? -exp10 : exp10];
+        long double const x = exp10 < 0 ? (long double)mantissa / pow10
+                                        : (long double)mantissa * pow10;
+        uint64_t significand;
+        std::memcpy(&significand, &x, sizeof(significand));
+        constexpr int dropped_bits = 64 - std::numeric_limits<T>::digits;
+        constexpr uint64_t half = uint64_t(1) << (dropped_bits - 1);
+        uint64_t const dropped =
+            significand & ((uint64_t(1) << dropped_bits) - 1);
+        if (dropped - (half - 4) <= 8 || x < std::numeric_limits<T>::min() ||
+            std::numeric_limits<T>::max() < x) {
+            return false;
+        }
+        attr = T(x);
+        return true;
+    }
+
+    struct no_real_chars
+    {
+        void push_back(char) {}
+    };
+
+    /** Parses a real number with the same syntax that `float_parser<T>`
+        accepts (the one defined by `detail_spirit_x3::real_policies<T>`),
+        or, if `Json` is `true`, with the syntax of a JSON number.  A JSON
+        number too large for `T` is converted to infinity, as `std::strtod()`
+        does; any other number too large for `T` does not match.
+        Where `std::from_chars()` for floating point types is available, the
+        result is correctly rounded.  Numbers with at most 19 significant
+        digits and a small exponent are converted while they are scanned,
+        exactly in `T` where possible, or else in x87 extended precision
+        when the extended result is provably far from a rounding boundary
+        of `T`.  Otherwise, the digits are handed to `std::from_chars()`;
+        they are read in place if `Iter` is a contiguous `char` iterator, or copied
+        into a local buffer as they are scanned if not. */
+    template<bool Json = false, typename T, typename Iter, typename Sentinel>
+    bool parse_real_precise(Iter & first, Sentinel last, T & attr)
+    {
+        if (first == last)
+            return false;
+
+        Iter it = first;
+        bool const neg = *it == '-';
+        if (neg || (!Json && *it == '+'))
+            ++it;
+        Iter const number_first = it;
+
+        // When the input cannot be handed to std::from_chars() directly, the
+        // characters are copied as they are scanned, so that the input is
+        // only traversed once.
+        constexpr bool contiguous = is_contiguous_char_iter_v<Iter>;
+        std::conditional_t<contiguous, no_real_chars, real_chars> chars;
+
+        // The first 19 significant digits, which always fit in 64 bits, and
+        // the power of ten they must be scaled by.  truncated indicates that
+        // a nonzero digit did not fit.
+        uint64_t mantissa = 0;
+        int mantissa_digits = 0;
+        int exp10 = 0;
+        bool truncated = false;
+
+        if (Json && it != last && *it == '0') {
+            // JSON allows no leading zeros; only the 0 of "01" is matched.
+            chars.push_back('0');
+            ++it;
+        } else {
+            for (; it != last && detail::is_digit(*it); ++it) {
+                chars.push_back((char)*it);
+                int const digit = *it - '0';
+                if (mantissa_digits < 19) {
+                    mantissa = mantissa * 10 + digit;
+                    mantissa_digits += mantissa != 0;
+                } else {
+                    truncated = truncated || digit;
+                    ++exp10;
+                }
+            }
+        }
+        bool const got_int = it != number_first;
+        // JSON requires an integer part, and has no "inf" or "nan".
+        if (Json && !got_int)
+            return false;
+        bool got_frac = false;
+        if (it != last && *it == '.') {
+            Iter const dot = it;
+            ++it;
+            chars.push_back('.');
+            for (; it != last && detail::is_digit(*it); ++it) {
+                chars.push_back((char)*it);
+                int const digit = *it - '0';
+                if (mantissa_digits < 19) {
+                    mantissa = mantissa * 10 + digit;
+                    mantissa_digits += mantissa != 0;
+                    --exp10;
+                } else {
+                    truncated = truncated || digit;
+                }
+            }
+            got_frac = it != std::next(dot);
+            // JSON requires digits after the '.'.
+            if ((Json || !got_int) && !got_frac)
+                it = dot;
+        }
+
+        if (!got_int && !got_frac) {
+            T n = 0;
+            it = number_first;
+            using policies = detail_spirit_x3::ureal_policies<T>;
+            if (policies::parse_nan(it, last, n) ||
+                policies::parse_inf(it, last, n)) {
+                attr = neg ? -n : n;
+                first = it;
+                return true;
+            }
+            return false;
+        }
+
+        if (it != last && (*it == 'e' || *it == 'E')) {
+            Iter const e = it;
+            ++it;
+            bool const neg_exp = it != last && *it == '-';
+            if (it != last && (*it == '-' || *it == '+'))
+                ++it;
+            if (it != last && detail::is_digit(*it)) {
+                chars.push_back('e');
+                if (neg_exp)
+                    chars.push_back('-');
+                int exp = 0;
+                for (; it != last && detail::is_digit(*it); ++it) {
+                    chars.push_back((char)*it);
+                    if (exp < 100000)
+                        exp = exp * 10 + (*it - '0');
+                }
+                exp10 += neg_exp ? -exp : exp;
+            } else {
+                it = e;
+            }
+        }
+
+        T n = 0;
+        bool success = false;
+        if constexpr (exact_fast_path_v<T>) {
+            success = !truncated && detail::exact_real(mantissa, exp10, n);
+            if constexpr (extended_fast_path) {
+                if (!success && !truncated)
+                    success = detail::extended_real(mantissa, exp10, n);
+            }
+        }
+        if (!success) {
+            // A value that is out of range is 0 if the number is less than
+            // 1, and an overflow otherwise.
+            bool const tiny = exp10 + mantissa_digits <= 0;
+            if constexpr (contiguous) {
+                char const * const p = detail::to_char_pointer(number_first);
+                success = detail::convert_real_chars<Json>(
+                    p, p + std::distance(number_first, it), tiny, n);
+            } else {
+                success = detail::convert_real_chars<Json>(
+                    chars.begin(), chars.end(), tiny, n);
+            }
+        }
+        if (!success)
+            return false;
+        attr = neg ? -n : n;
+        first = it;
+        return true;
+    }
+}
+
+#endif
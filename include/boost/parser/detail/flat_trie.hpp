@@ -0,0 +1,266 @@
+#ifndef BOOST_PARSER_DETAIL_FLAT_TRIE_HPP
+#define BOOST_PARSER_DETAIL_FLAT_TRIE_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/case_fold.hpp>
+#include <boost/parser/detail/text/transcode_view.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+
+namespace boost::parser::detail {
+
+    /** Returns the case folding of UTF-8 string `str`, as code points. */
+    inline std::vector<char32_t> case_folded_key(std::string_view str)
+    {
+        std::vector<char32_t> retval;
+        for (char32_t cp : str | text::as_utf32) {
+            detail::case_fold(cp, std::back_inserter(retval));
+        }
+        return retval;
+    }
+
+    /** An immutable trie keyed on code points, used for symbol table lookups
+        when the table has not been changed during the current parse.
+
+        The nodes are stored in one array, in which the children of each node
+        are contiguous, and sorted by the code point that leads to them.
+        Finding a child is therefore a scan (or binary search) over a small
+        contiguous range of nodes, rather than a walk over separately
+        allocated nodes.  Values are kept in a side array.
+        Children of the root with ASCII keys are also found through a direct
+        lookup table.
+
+        If `NoCase` is true, the keys are case folded when the trie is
+        built, and each code point of the input is case folded as it is
+        looked up, so that a key matches input in any case.  Keys that are
+        the same once case folded are the same key. */
+    template<typename T, bool NoCase = false>
+    struct flat_trie
+    {
+        struct match_result
+        {
+            std::ptrdiff_t size = 0;
+            T const * value = nullptr;
+        };
+
+        flat_trie() : nodes_(1) {}
+
+        /** Builds the trie from `elements`.  As with `text::trie::insert()`,
+            if a key appears more than once, the first value associated with
+            it is the one that is kept. */
+        explicit flat_trie(
+            std::vector<std::pair<std::string_view, T>> const & elements)
+        {
+            struct key_and_index
+            {
+                std::vector<char32_t> key;
+                std::size_t index;
+            };
+            std::vector<key_and_index> keys;
+            keys.reserve(elements.size());
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                if constexpr (NoCase) {
+                    keys.push_back(key_and_index{
+                        detail::case_folded_key(elements[i].first), i});
+                } else {
+                    auto const r = elements[i].first | text::as_utf32;
+                    keys.push_back(key_and_index{
+                        std::vector<char32_t>(r.begin(), r.end()), i});
+                }
+            }
+            std::stable_sort(
+                keys.begin(),
+                keys.end(),
+                [](key_and_index const & lhs, key_and_index const & rhs) {
+                    return lhs.key < rhs.key;
+                });
+            keys.erase(
+                std::unique(
+                    keys.begin(),
+                    keys.end(),
+                    [](key_and_index const & lhs, key_and_index const & rhs) {
+                        return lhs.key == rhs.key;
+                    }),
+                keys.end());
+            values_.reserve(keys.size());
+
+            // Each pending node covers the subrange of keys that share its
+            // prefix.  All the children of a node are created at once, so
+            // they end up contiguous in nodes_.  Pending nodes are handled
+            // depth-first, so a node's children are usually allocated close
+            // to it.
+            struct pending_node
+            {
+                uint32_t index;
+                std::size_t first;
+                std::size_t last;
+                std::size_t depth;
+            };
+            nodes_.push_back(node{});
+            std::vector<pending_node> stack{{0, 0, keys.size(), 0}};
+            while (!stack.empty()) {
+                pending_node const p = stack.back();
+                stack.pop_back();
+                std::size_t first = p.first;
+                if (first != p.last && keys[first].key.size() == p.depth) {
+                    nodes_[p.index].value = (uint32_t)values_.size();
+                    values_.push_back(elements[keys[first].index].second);
+                    ++first;
+                }
+                uint32_t const first_child = (uint32_t)nodes_.size();
+                nodes_[p.index].first_child = first_child;
+                auto const stack_size = stack.size();
+                while (first != p.last) {
+                    char32_t const cp = keys[first].key[p.depth];
+                    std::size_t last = first + 1;
+                    while (last != p.last && keys[last].key[p.depth] == cp) {
+                        ++last;
+                    }
+                    uint32_t const child = (uint32_t)nodes_.size();
+                    nodes_.push_back(node{cp});
+                    if (p.index == 0 && cp < 128)
+                        root_ascii_[cp] = child;
+                    stack.push_back(
+                        pending_node{child, first, last, p.depth + 1});
+                    first = last;
+                }
+                nodes_[p.index].children =
+                    (uint32_t)nodes_.size() - first_child;
+                std::reverse(stack.begin() + stack_size, stack.end());
+            }
+        }
+
+        /** Returns the longest prefix of `[first, last)` that is a key in
+            *this, and its value.  `value` is null if there is no match.
+            `size` is the length of the prefix in elements of `[first,
+            last)`; if `NoCase` is true, a prefix must end where the case
+            folding of one of those elements does. */
+        template<typename Iter, typename Sentinel>
+        match_result longest_match(Iter first, Sentinel last) const
+        {
+            match_result retval;
+            uint32_t n = 0;
+            std::ptrdiff_t size = 0;
+            for (; first != last; ++first) {
+                uint32_t child = 0;
+                if constexpr (NoCase) {
+                    char32_t folded[longest_mapping];
+                    char32_t const * const folded_last =
+                        detail::case_fold(*first, folded);
+                    child = find_child(n, folded[0]);
+                    for (char32_t const * it = folded + 1;
+                         child && it != folded_last;
+                         ++it) {
+                        child = find_child(child, *it);
+                    }
+                } else {
+                    child = find_child(n, *first);
+                }
+                if (!child)
+                    break;
+                n = child;
+                ++size;
+                if (nodes_[n].value != no_value)
+                    retval = match_result{size, &values_[nodes_[n].value]};
+            }
+            // Like text::trie, an empty key matches only if no code point of
+            // the input is consumed.
+            if (!retval.value && n == 0 && nodes_[0].value != no_value)
+                retval = match_result{0, &values_[nodes_[0].value]};
+            return retval;
+        }
+
+    private:
+        static constexpr uint32_t no_value = uint32_t(-1);
+
+        struct node
+        {
+            char32_t key = 0; // The code point that leads to this node.
+            uint32_t first_child = 0;
+            uint32_t children = 0;
+            uint32_t value = no_value;
+        };
+
+        // Returns 0 if there is no such child, since the root is never a
+        // child.
+        uint32_t find_child(uint32_t n, char32_t cp) const
+        {
+            if (n == 0 && cp < 128)
+                return root_ascii_[cp];
+            return find_child(nodes_[n], cp);
+        }
+        uint32_t find_child(node const & n, char32_t cp) const
+        {
+            node const * const first = nodes_.data() + n.first_child;
+            node const * const last = first + n.children;
+            node const * it = first;
+            if (n.children <= 8) {
+                while (it != last && it->key < cp) {
+                    ++it;
+                }
+            } else {
+                it = std::lower_bound(
+                    first, last, cp, [](node const & n, char32_t cp) {
+                        return n.key < cp;
+                    });
+            }
+            if (it == last || it->key != cp)
+                return 0;
+            return n.first_child + uint32_t(it - first);
+        }
+
+        std::vector<node> nodes_;
+        std::vector<T> values_;
+        uint32_t root_ascii_[128] = {};
+    };
+
+    /** Builds a flat_trie on first use, and hands out the same one to all
+        later users, until reset() is called.  The first use may happen
+        concurrently in several parses, so building is done under a lock.
+        Copies start out empty. */
+    template<typename T, bool NoCase = false>
+    struct lazy_flat_trie
+    {
+        lazy_flat_trie() = default;
+        lazy_flat_trie(lazy_flat_trie const &) {}
+        lazy_flat_trie & operator=(lazy_flat_trie const &)
+        {
+            reset();
+            return *this;
+        }
+        ~lazy_flat_trie() { reset(); }
+
+        flat_trie<T, NoCase> const &
+        get(std::vector<std::pair<std::string_view, T>> const & elements) const
+        {
+            flat_trie<T, NoCase> const * retval =
+                trie_.load(std::memory_order_acquire);
+            if (!retval) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                retval = trie_.load(std::memory_order_relaxed);
+                if (!retval) {
+                    retval = new flat_trie<T, NoCase>(elements);
+                    trie_.store(retval, std::memory_order_release);
+                }
+            }
+            return *retval;
+        }
+
+        void reset() { delete trie_.exchange(nullptr); }
+
+    private:
+        mutable std::atomic<flat_trie<T, NoCase> const *> trie_{nullptr};
+        mutable std::mutex mutex_;
+    };
+
+}
+
+#endif
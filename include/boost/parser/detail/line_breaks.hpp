@@ -0,0 +1,76 @@
+#ifndef BOOST_PARSER_DETAIL_LINE_BREAKS_HPP
+#define BOOST_PARSER_DETAIL_LINE_BREAKS_HPP
+
+#include <boost/parser/config.hpp>
+#include <boost/parser/detail/skip_ws.hpp>
+
+#if !defined(BOOST_PARSER_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOOST_PARSER_LINE_BREAKS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#include <emmintrin.h>
+#define BOOST_PARSER_LINE_BREAKS_SSE2 1
+#endif
+#endif
+
+#include <type_traits>
+
+
+namespace boost::parser::detail {
+
+    /** Calls `f(p)` for each `p` in `[first, last)` that points to a line
+        break, in order.  As elsewhere in the error reporting code, a `char`
+        is a line break if it is one of `'\n'`, `'\v'`, `'\f'` and `'\r'`
+        (or, where `char` is unsigned, U+0085).  Where SSE2 or AVX2 is
+        available, the chars are classified 16 or 32 at a time. */
+    template<typename F>
+    void for_each_line_break(char const * first, char const * last, F && f)
+    {
+#if defined(BOOST_PARSER_LINE_BREAKS_AVX2) ||                                  \
+    defined(BOOST_PARSER_LINE_BREAKS_SSE2)
+        if constexpr (std::is_signed_v<char>) {
+#if defined(BOOST_PARSER_LINE_BREAKS_AVX2)
+            constexpr int block = 32;
+            __m256i const nl = _mm256_set1_epi8('\n');
+            __m256i const three = _mm256_set1_epi8(3);
+#else
+            constexpr int block = 16;
+            __m128i const nl = _mm_set1_epi8('\n');
+            __m128i const three = _mm_set1_epi8(3);
+#endif
+            while (block <= last - first) {
+                // c - '\n' <= 3, as unsigned chars.
+#if defined(BOOST_PARSER_LINE_BREAKS_AVX2)
+                __m256i const chars =
+                    _mm256_loadu_si256((__m256i const *)first);
+                __m256i const offset = _mm256_sub_epi8(chars, nl);
+                unsigned int breaks = (unsigned int)_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(offset, three), offset));
+#else
+                __m128i const chars = _mm_loadu_si128((__m128i const *)first);
+                __m128i const offset = _mm_sub_epi8(chars, nl);
+                unsigned int breaks = (unsigned int)_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_min_epu8(offset, three), offset));
+#endif
+                while (breaks) {
+                    f(first + detail::count_trailing_zeros(breaks));
+                    breaks &= breaks - 1;
+                }
+                first += block;
+            }
+        }
+#endif
+        for (; first != last; ++first) {
+            char const c = *first;
+            if (('\n' <= c && c <= '\r') ||
+                (!std::is_signed_v<char> && (unsigned char)c == 0x85)) {
+                f(first);
+            }
+        }
+    }
+
+}
+
+#endif
@@ -119,6 +119,12 @@ namespace boost { namespace parser { namespace detail {
         lexeme_parser<Parser> const & parser,
         std::ostream & os,
         int components = 0);
+    template<typename Context, typename Parser>
+    void print_parser(
+        Context const & context,
+        views_parser<Parser> const & parser,
+        std::ostream & os,
+        int components = 0);
 
     template<typename Context, typename Parser>
     void print_parser(
@@ -127,6 +133,13 @@ namespace boost { namespace parser { namespace detail {
         std::ostream & os,
         int components = 0);
 
+    template<typename Context, typename Parser>
+    void print_parser(
+        Context const & context,
+        memoize_parser<Parser> const & parser,
+        std::ostream & os,
+        int components = 0);
+
     template<typename Context, typename Parser, typename SkipParser>
     void print_parser(
         Context const & context,
@@ -304,24 +317,31 @@ namespace boost { namespace parser { namespace detail {
         std::ostream & os,
         int components = 0);
 
-    template<typename Context, typename T>
+    template<typename Context, typename T, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<T> const & parser,
+        float_parser<T, CorrectlyRounded> const & parser,
         std::ostream & os,
         int components = 0);
 
-    template<typename Context>
+    template<typename Context, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<float> const & parser,
+        float_parser<float, CorrectlyRounded> const & parser,
         std::ostream & os,
         int components = 0);
 
-    template<typename Context>
+    template<typename Context, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<double> const & parser,
+        float_parser<double, CorrectlyRounded> const & parser,
+        std::ostream & os,
+        int components = 0);
+
+    template<typename Context, typename T>
+    void print_parser(
+        Context const & context,
+        json_number_parser<T> const & parser,
         std::ostream & os,
         int components = 0);
 
@@ -607,6 +627,15 @@ namespace boost { namespace parser { namespace detail {
         std::string name_;
     };
 
+    // Returned by scoped_trace() for parses that were not started with
+    // trace::on.  The user-provided special members keep "unused variable"
+    // warnings away from the "auto _ = scoped_trace(...)" call sites.
+    struct null_scoped_trace
+    {
+        null_scoped_trace() noexcept {}
+        ~null_scoped_trace() {}
+    };
+
     template<
         typename Parser,
         typename Iter,
@@ -621,27 +650,33 @@ namespace boost { namespace parser { namespace detail {
         flags f,
         Attribute const & attr)
     {
-        std::stringstream oss;
-        if (detail::do_trace(f))
-            detail::print_parser(context, parser, oss);
-        return scoped_trace_t<Iter, Sentinel, Context, Attribute>(
-            first, last, context, f, attr, oss.str());
+        if constexpr (Context::do_trace) {
+            std::stringstream oss;
+            if (detail::do_trace(f))
+                detail::print_parser(context, parser, oss);
+            return scoped_trace_t<Iter, Sentinel, Context, Attribute>(
+                first, last, context, f, attr, oss.str());
+        } else {
+            return null_scoped_trace{};
+        }
     }
 
     template<typename Context, typename Attribute>
     auto final_trace(Context const & context, flags f, Attribute const & attr)
     {
-        if (!detail::do_trace(f))
-            return;
+        if constexpr (Context::do_trace) {
+            if (!detail::do_trace(f))
+                return;
 
-        std::cout << "--------------------\n";
-        if (*context.pass_) {
-            std::cout << "parse succeeded\n";
-            detail::print_attribute(detail::resolve(context, attr), 0);
-        } else {
-            std::cout << "parse failed\n";
+            std::cout << "--------------------\n";
+            if (*context.pass_) {
+                std::cout << "parse succeeded\n";
+                detail::print_attribute(detail::resolve(context, attr), 0);
+            } else {
+                std::cout << "parse failed\n";
+            }
+            std::cout << "--------------------" << std::endl;
         }
-        std::cout << "--------------------" << std::endl;
     }
 
 }}}
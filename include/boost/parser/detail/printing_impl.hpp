@@ -303,6 +303,16 @@ namespace boost { namespace parser { namespace detail {
         detail::print_directive(
             context, "lexeme", parser.parser_, os, components);
     }
+    template<typename Context, typename Parser>
+    void print_parser(
+        Context const & context,
+        views_parser<Parser> const & parser,
+        std::ostream & os,
+        int components)
+    {
+        detail::print_directive(
+            context, "views", parser.parser_, os, components);
+    }
 
     template<typename Context, typename Parser>
     void print_parser(
@@ -315,6 +325,17 @@ namespace boost { namespace parser { namespace detail {
             context, "no_case", parser.parser_, os, components);
     }
 
+    template<typename Context, typename Parser>
+    void print_parser(
+        Context const & context,
+        memoize_parser<Parser> const & parser,
+        std::ostream & os,
+        int components)
+    {
+        detail::print_directive(
+            context, "memoize", parser.parser_, os, components);
+    }
+
     template<typename Context, typename Parser, typename SkipParser>
     void print_parser(
         Context const & context,
@@ -782,36 +803,55 @@ namespace boost { namespace parser { namespace detail {
         os << "long_long";
     }
 
-    template<typename Context, typename T>
+    template<typename Context, typename T, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<T> const & parser,
+        float_parser<T, CorrectlyRounded> const & parser,
         std::ostream & os,
         int components)
     {
+        if (CorrectlyRounded)
+            os << "precise_";
         os << "float<" << detail::type_name<T>() << ">";
     }
 
-    template<typename Context>
+    template<typename Context, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<float> const & parser,
+        float_parser<float, CorrectlyRounded> const & parser,
         std::ostream & os,
         int components)
     {
+        if (CorrectlyRounded)
+            os << "precise_";
         os << "float_";
     }
 
-    template<typename Context>
+    template<typename Context, bool CorrectlyRounded>
     void print_parser(
         Context const & context,
-        float_parser<double> const & parser,
+        float_parser<double, CorrectlyRounded> const & parser,
         std::ostream & os,
         int components)
     {
+        if (CorrectlyRounded)
+            os << "precise_";
         os << "double_";
     }
 
+    template<typename Context, typename T>
+    void print_parser(
+        Context const & context,
+        json_number_parser<T> const & parser,
+        std::ostream & os,
+        int components)
+    {
+        if constexpr (std::is_same_v<T, double>)
+            os << "json_number";
+        else
+            os << "json_number<" << detail::type_name<T>() << ">";
+    }
+
     template<
         typename Context,
         typename ParserTuple,
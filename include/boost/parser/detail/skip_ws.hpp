@@ -0,0 +1,118 @@
+#ifndef BOOST_PARSER_DETAIL_SKIP_WS_HPP
+#define BOOST_PARSER_DETAIL_SKIP_WS_HPP
+
+#include <boost/parser/config.hpp>
+
+#if !defined(BOOST_PARSER_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOOST_PARSER_SKIP_WS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#include <emmintrin.h>
+#define BOOST_PARSER_SKIP_WS_SSE2 1
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
+namespace boost::parser::detail {
+
+    // Returns true if c is one of the ASCII chars that ws (or blank, if
+    // NoNewlines is true) matches: space, and tab through cr (or just tab).
+    template<bool NoNewlines>
+    constexpr bool is_ascii_ws(char c)
+    {
+        if constexpr (NoNewlines)
+            return c == ' ' || c == '\t';
+        else
+            return c == ' ' || ('\t' <= c && c <= '\r');
+    }
+
+#if defined(BOOST_PARSER_SKIP_WS_AVX2) || defined(BOOST_PARSER_SKIP_WS_SSE2)
+    inline int count_trailing_zeros(unsigned int x)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long retval;
+        _BitScanForward(&retval, x);
+        return (int)retval;
+#else
+        return __builtin_ctz(x);
+#endif
+    }
+#endif
+
+    /** Returns the end of the run of ASCII whitespace that begins at
+        `first`, where whitespace is what `ws` matches (or `blank`, if
+        `NoNewlines` is true).  Where SSE2 or AVX2 is available, the chars
+        are classified 16 or 32 at a time.  Non-ASCII whitespace ends the
+        run; the caller is expected to deal with it. */
+    template<bool NoNewlines>
+    char const * skip_ascii_ws(char const * first, char const * last)
+    {
+        // Whitespace runs are usually short, so the first few chars are
+        // looked at one at a time.
+        for (int i = 0; i < 4; ++i, ++first) {
+            if (first == last || !detail::is_ascii_ws<NoNewlines>(*first))
+                return first;
+        }
+
+#if defined(BOOST_PARSER_SKIP_WS_AVX2)
+        __m256i const space = _mm256_set1_epi8(' ');
+        __m256i const tab = _mm256_set1_epi8('\t');
+        __m256i const four = _mm256_set1_epi8(4);
+        while (32 <= last - first) {
+            __m256i const chars =
+                _mm256_loadu_si256((__m256i const *)first);
+            __m256i ws = _mm256_cmpeq_epi8(chars, space);
+            if constexpr (NoNewlines) {
+                ws = _mm256_or_si256(ws, _mm256_cmpeq_epi8(chars, tab));
+            } else {
+                // c - '\t' <= 4, as unsigned chars.
+                __m256i const offset = _mm256_sub_epi8(chars, tab);
+                ws = _mm256_or_si256(
+                    ws,
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(offset, four), offset));
+            }
+            unsigned int const not_ws =
+                ~(unsigned int)_mm256_movemask_epi8(ws);
+            if (not_ws)
+                return first + detail::count_trailing_zeros(not_ws);
+            first += 32;
+        }
+#elif defined(BOOST_PARSER_SKIP_WS_SSE2)
+        __m128i const space = _mm_set1_epi8(' ');
+        __m128i const tab = _mm_set1_epi8('\t');
+        __m128i const four = _mm_set1_epi8(4);
+        while (16 <= last - first) {
+            __m128i const chars = _mm_loadu_si128((__m128i const *)first);
+            __m128i ws = _mm_cmpeq_epi8(chars, space);
+            if constexpr (NoNewlines) {
+                ws = _mm_or_si128(ws, _mm_cmpeq_epi8(chars, tab));
+            } else {
+                // c - '\t' <= 4, as unsigned chars.
+                __m128i const offset = _mm_sub_epi8(chars, tab);
+                ws = _mm_or_si128(
+                    ws, _mm_cmpeq_epi8(_mm_min_epu8(offset, four), offset));
+            }
+            unsigned int const not_ws =
+                ~(unsigned int)_mm_movemask_epi8(ws) & 0xffffu;
+            if (not_ws)
+                return first + detail::count_trailing_zeros(not_ws);
+            first += 16;
+        }
+#endif
+
+        for (; first != last; ++first) {
+            if (!detail::is_ascii_ws<NoNewlines>(*first))
+                break;
+        }
+        return first;
+    }
+
+}
+
+#endif
@@ -3147,14 +3147,14 @@ namespace boost::parser::detail { namespace text {
                 buf_last_ = uint8_t(it - buf_.begin());
             } else {
                 auto buf = buf_;
-#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS
+#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS && BOOST_PARSER_USE_EXCEPTIONS
                 try {
 #endif
                     char32_t cp = decode_code_point();
                     auto it = encode_code_point(cp, buf_.begin());
                     buf_index_ = 0;
                     buf_last_ = it - buf_.begin();
-#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS
+#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS && BOOST_PARSER_USE_EXCEPTIONS
                 } catch (...) {
                     buf_ = buf;
                     curr() = initial;
@@ -3184,7 +3184,7 @@ namespace boost::parser::detail { namespace text {
                 to_increment_ = std::distance(curr(), initial);
             } else {
                 auto buf = buf_;
-#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS
+#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS && BOOST_PARSER_USE_EXCEPTIONS
                 try {
 #endif
                     char32_t cp = decode_code_point_reverse();
@@ -3192,7 +3192,7 @@ namespace boost::parser::detail { namespace text {
                     buf_last_ = it - buf_.begin();
                     buf_index_ = buf_last_ - 1;
                     to_increment_ = std::distance(curr(), initial);
-#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS
+#if BOOST_PARSER_DETAIL_TEXT_USE_CONCEPTS && BOOST_PARSER_USE_EXCEPTIONS
                 } catch (...) {
                     buf_ = buf;
                     curr() = initial;
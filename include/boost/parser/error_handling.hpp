@@ -2,15 +2,19 @@
 #define BOOST_PARSER_ERROR_HANDLING_HPP
 
 #include <boost/parser/error_handling_fwd.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+#include <boost/parser/detail/line_breaks.hpp>
 #include <boost/parser/detail/printing.hpp>
 
 #include <boost/parser/detail/text/algorithm.hpp>
 #include <boost/parser/detail/text/transcode_iterator.hpp>
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 
 namespace boost { namespace parser {
@@ -24,6 +28,14 @@ namespace boost { namespace parser {
 
         inline constexpr int eol_cp_mask =
             0x000a | 0x000b | 0x000c | 0x000d | 0x0085 | 0x2028 | 0x2029;
+
+        template<typename T>
+        bool is_eol_cp(T c)
+        {
+            return (c & eol_cp_mask) == c &&
+                   std::find(eol_cps.begin(), eol_cps.end(), c) !=
+                       eol_cps.end();
+        }
     }
 
     /** Returns the `line_position` for `it`, counting lines from the
@@ -35,10 +47,7 @@ namespace boost { namespace parser {
         auto retval = line_position<Iter>{first, 0, 0};
         for (Iter pos = first; pos != it; ++pos) {
             auto const c = *pos;
-            bool const found =
-                (c & detail::eol_cp_mask) == c &&
-                std::find(detail::eol_cps.begin(), detail::eol_cps.end(), c) !=
-                    detail::eol_cps.end();
+            bool const found = detail::is_eol_cp(c);
             if (found) {
                 retval.line_start = std::next(pos);
                 retval.column_number = 0;
@@ -52,17 +61,140 @@ namespace boost { namespace parser {
         return retval;
     }
 
+    /** An index of the starts of the lines of an input, for finding the
+        `line_position`s of many iterators into the same input.  The input
+        is scanned once, when the index is built; after that, finding a
+        position takes a binary search, and a walk from the start of its
+        line.  Positions are the same as those `find_line_position()`
+        returns.  `Iter` must be random access, or a transcoding iterator
+        over a random access iterator. */
+    template<typename Iter>
+    struct line_index
+    {
+        template<typename Sentinel>
+        line_index(Iter first, Sentinel last) : first_(first)
+        {
+            if constexpr (
+                detail::is_contiguous_char_iter_v<Iter> &&
+                std::is_same_v<Iter, Sentinel>) {
+                if (first == last)
+                    return;
+                char const * const p_first = detail::to_char_pointer(first);
+                detail::for_each_line_break(
+                    p_first, p_first + (last - first), [&](char const * p) {
+                        add_line_break(
+                            p - p_first + 1,
+                            std::next(first, p - p_first + 1),
+                            *p == '\n' && p != p_first && p[-1] == '\r');
+                    });
+            } else {
+                bool prev_cr = false;
+                for (Iter pos = first; pos != last; ++pos) {
+                    auto const c = *pos;
+                    if (detail::is_eol_cp(c)) {
+                        Iter const next = std::next(pos);
+                        add_line_break(
+                            detail::iter_position(first, next),
+                            next,
+                            prev_cr && c == 0x000a);
+                    }
+                    prev_cr = c == 0x000d;
+                }
+            }
+        }
+
+        /** Returns the `line_position` for `it`, counting lines from the
+            beginning of the input. */
+        line_position<Iter> position(Iter it) const
+        {
+            std::ptrdiff_t const offset = detail::iter_position(first_, it);
+            auto const line = std::upper_bound(
+                lines_.begin(),
+                lines_.end(),
+                offset,
+                [](std::ptrdiff_t offset, line_start const & line) {
+                    return offset < line.offset_;
+                });
+            if (line == lines_.begin())
+                return {first_, 0, std::distance(first_, it)};
+            auto const & start = *std::prev(line);
+            return {start.it_, start.line_number_, std::distance(start.it_, it)};
+        }
+
+    private:
+        static_assert(detail::has_iter_position_v<Iter>);
+
+        struct line_start
+        {
+            std::ptrdiff_t offset_;
+            Iter it_;
+            int64_t line_number_;
+        };
+
+        // The LF of a CRLF starts a new (empty) line at the same line
+        // number, just as in find_line_position().
+        void add_line_break(std::ptrdiff_t offset, Iter next, bool crlf)
+        {
+            int64_t const line_number =
+                (lines_.empty() ? 0 : lines_.back().line_number_) + !crlf;
+            lines_.push_back(line_start{offset, next, line_number});
+        }
+
+        Iter first_;
+        std::vector<line_start> lines_;
+    };
+
     /** Returns the iterator to the end of the line in which `it` is
         found.  */
     template<typename Iter, typename Sentinel>
     Iter find_line_end(Iter it, Sentinel last)
     {
-        return parser::detail::text::find_if(it, last, [](auto c) {
-            return (c & detail::eol_cp_mask) == c &&
-                   std::find(
-                       detail::eol_cps.begin(), detail::eol_cps.end(), c) !=
-                       detail::eol_cps.end();
-        });
+        return parser::detail::text::find_if(
+            it, last, [](auto c) { return detail::is_eol_cp(c); });
+    }
+
+    namespace detail {
+        template<typename Iter, typename Sentinel>
+        std::ostream & write_formatted_message_at(
+            std::ostream & os,
+            std::string_view filename,
+            line_position<Iter> const & position,
+            Iter it,
+            Sentinel last,
+            std::string_view message,
+            int64_t preferred_max_line_length,
+            int64_t max_after_caret)
+        {
+            if (!filename.empty())
+                os << filename << ':';
+            os << (position.line_number + 1) << ':' << position.column_number
+               << ": " << message << " here";
+            if (it == last)
+                os << " (end of input)";
+            os << ":\n";
+
+            std::string underlining(
+                std::distance(position.line_start, it), ' ');
+            detail::trace_input(os, position.line_start, it, false, 1u << 31);
+            if (it == last) {
+                os << '\n' << underlining << "^\n";
+                return os;
+            }
+
+            underlining += '^';
+
+            int64_t const limit = (std::max)(
+                preferred_max_line_length,
+                (int64_t)underlining.size() + max_after_caret);
+
+            int64_t i = (int64_t)underlining.size();
+            auto const line_end = parser::find_line_end(std::next(it), last);
+            detail::trace_input(os, it, line_end, false, limit - i);
+
+            os << '\n' << underlining << '\n';
+
+            return os;
+        }
     }
 
     template<typename Iter, typename Sentinel>
@@ -76,35 +208,37 @@ namespace boost { namespace parser {
         int64_t preferred_max_line_length,
         int64_t max_after_caret)
     {
-        if (!filename.empty())
-            os << filename << ':';
-        auto const position = parser::find_line_position(first, it);
-        os << (position.line_number + 1) << ':' << position.column_number
-           << ": " << message << " here";
-        if (it == last)
-            os << " (end of input)";
-        os << ":\n";
-
-        std::string underlining(std::distance(position.line_start, it), ' ');
-        detail::trace_input(os, position.line_start, it, false, 1u << 31);
-        if (it == last) {
-            os << '\n' << underlining << "^\n";
-            return os;
-        }
-
-        underlining += '^';
-
-        int64_t const limit = (std::max)(
+        return detail::write_formatted_message_at(
+            os,
+            filename,
+            parser::find_line_position(first, it),
+            it,
+            last,
+            message,
             preferred_max_line_length,
-            (int64_t)underlining.size() + max_after_caret);
-
-        int64_t i = (int64_t)underlining.size();
-        auto const line_end = parser::find_line_end(std::next(it), last);
-        detail::trace_input(os, it, line_end, false, limit - i);
-
-        os << '\n' << underlining << '\n';
+            max_after_caret);
+    }
 
-        return os;
+    template<typename Iter, typename Sentinel>
+    std::ostream & write_formatted_message(
+        std::ostream & os,
+        std::string_view filename,
+        line_index<Iter> const & index,
+        Iter it,
+        Sentinel last,
+        std::string_view message,
+        int64_t preferred_max_line_length,
+        int64_t max_after_caret)
+    {
+        return detail::write_formatted_message_at(
+            os,
+            filename,
+            index.position(it),
+            it,
+            last,
+            message,
+            preferred_max_line_length,
+            max_after_caret);
     }
 
 #if defined(_MSC_VER)
@@ -174,6 +308,54 @@ namespace boost { namespace parser {
     }
 #endif
 
+    namespace detail {
+        // The address of line_index_id<T> identifies T without RTTI.
+        template<typename T>
+        inline constexpr char line_index_id = 0;
+
+        // Writes a diagnostic about it to os.  The first diagnostic written
+        // during a parse builds a line_index for the input, and keeps it in
+        // the parse context, so the diagnostics that follow in the same
+        // parse do not each have to count lines from the start of the input.
+        template<typename Context, typename Iter>
+        void write_diagnostic(
+            std::ostream & os,
+            std::string_view filename,
+            Context const & context,
+            Iter it,
+            std::string_view message)
+        {
+            using context_iter_t = remove_cv_ref_t<decltype(context.first_)>;
+            if constexpr (
+                std::is_same_v<Iter, context_iter_t> &&
+                has_iter_position_v<Iter>) {
+                if (context.symbol_table_tries_) {
+                    any_copyable & index = (*context.symbol_table_tries_)[(
+                        void *)&line_index_id<Iter>];
+                    if (index.empty()) {
+                        index = line_index<Iter>(
+                            parser::_begin(context), parser::_end(context));
+                    }
+                    parser::write_formatted_message(
+                        os,
+                        filename,
+                        index.cast<line_index<Iter>>(),
+                        it,
+                        parser::_end(context),
+                        message);
+                    return;
+                }
+            }
+            parser::write_formatted_message(
+                os,
+                filename,
+                parser::_begin(context),
+                it,
+                parser::_end(context),
+                message);
+        }
+    }
+
     /** An error handler that allows users to supply callbacks to handle the
         reporting of warnings and errors.  The reporting of errors and/or
         warnings can be suppressed by supplying one or both
@@ -226,13 +408,7 @@ namespace boost { namespace parser {
             if (!cb)
                 return;
             std::stringstream ss;
-            parser::write_formatted_message(
-                ss,
-                filename_,
-                parser::_begin(context),
-                it,
-                parser::_end(context),
-                message);
+            detail::write_diagnostic(ss, filename_, context, it, message);
             cb(ss.str());
         }
 
@@ -296,13 +472,7 @@ namespace boost { namespace parser {
         Context const & context,
         Iter it) const
     {
-        parser::write_formatted_message(
-            std::cerr,
-            "",
-            parser::_begin(context),
-            it,
-            parser::_end(context),
-            message);
+        detail::write_diagnostic(std::cerr, "", context, it, message);
     }
 
     template<typename Context>
@@ -336,13 +506,7 @@ namespace boost { namespace parser {
         std::ostream * os = kind == diagnostic_kind::error ? err_os_ : warn_os_;
         if (!os)
             os = &std::cerr;
-        parser::write_formatted_message(
-            *os,
-            filename_,
-            parser::_begin(context),
-            it,
-            parser::_end(context),
-            message);
+        detail::write_diagnostic(*os, filename_, context, it, message);
     }
 
     template<typename Context>
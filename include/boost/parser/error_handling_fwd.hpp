@@ -6,6 +6,7 @@
 #include <boost/parser/detail/text/transcode_view.hpp>
 
 #include <iostream>
+#include <sstream>
 #include <string_view>
 
 
@@ -31,6 +32,53 @@ namespace boost { namespace parser {
         Iter iter;
     };
 
+    /** Describes an expectation failure (the failure of `b` in `a > b`),
+        consisting of an iterator to the point of failure, and the name of the
+        failed parser or rule in `what()`.  An `expectation_failure` is passed
+        to an error handler that can accept one, instead of throwing a
+        `parse_error`.  It is not an exception, and the name in `what()` is
+        only produced if `what()` is called.  An `expectation_failure` refers
+        to the state of the parse, so it is only valid during the call to the
+        error handler. */
+    template<typename Iter>
+    struct expectation_failure
+    {
+        using print_function = void (*)(
+            void const * parser, void const * context, std::ostream & os);
+
+        expectation_failure(
+            Iter it,
+            void const * parser,
+            void const * context,
+            print_function print) :
+            iter(it), parser_(parser), context_(context), print_(print)
+        {}
+
+        /** Returns the name of the failed parser or rule, as
+            `parse_error::what()` would. */
+        std::string what() const
+        {
+            std::ostringstream oss;
+            print_(parser_, context_, oss);
+            return oss.str();
+        }
+
+        /** Returns the equivalent `parse_error`, for use with functions that
+            take one, such as
+            `write_formatted_expectation_failure_error_message()`. */
+        parse_error<Iter> to_parse_error() const
+        {
+            return parse_error<Iter>(iter, what());
+        }
+
+        Iter iter;
+
+    private:
+        void const * parser_;
+        void const * context_;
+        print_function print_;
+    };
+
     /** A position within a line, consisting of an iterator to the start of
         the line, the line number, and the column number. */
     template<typename Iter>
@@ -54,6 +102,24 @@ namespace boost { namespace parser {
         int64_t preferred_max_line_length = 80,
         int64_t max_after_caret = 40);
 
+    template<typename Iter>
+    struct line_index;
+
+    /** Writes a formatted message (meaning prefixed with the file name, line,
+        and column number) to `os`.  The line and column number are looked up
+        in `index`, which is much faster than counting them from the start of
+        the input when there are many messages about one long input. */
+    template<typename Iter, typename Sentinel>
+    std::ostream & write_formatted_message(
+        std::ostream & os,
+        std::string_view filename,
+        line_index<Iter> const & index,
+        Iter it,
+        Sentinel last,
+        std::string_view message,
+        int64_t preferred_max_line_length = 80,
+        int64_t max_after_caret = 40);
+
 #if defined(_MSC_VER) || defined(BOOST_PARSER_DOXYGEN)
     /** Writes a formatted message (meaning prefixed with the file name, line,
         and column number) to `os`.  This overload is Windows-only. */
@@ -0,0 +1,219 @@
+#ifndef BOOST_PARSER_MAPPED_FILE_HPP
+#define BOOST_PARSER_MAPPED_FILE_HPP
+
+#include <boost/parser/config.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BOOST_PARSER_MAPPED_FILE_POSIX 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+
+namespace boost::parser {
+
+    /** A read-only range of the `char`s in a file.
+
+        On POSIX systems, a regular file is memory-mapped rather than read,
+        so there is no copy of the file in memory besides the page cache's,
+        and the pages are only read in as the parse reaches them.  The
+        mapping is advised to be read sequentially, and, for large files, to
+        use huge pages where the system supports that.  Other files (pipes,
+        for instance), and all files on other systems, are read into a
+        buffer.
+
+        The iterators are `char const *`, so a `mapped_file` can be passed to
+        `parse()`, `search_all()`, `split()`, `replace()`, etc., just like a
+        `std::string` with the same contents, and gets the same fast paths
+        for contiguous input.  As with a `std::string`, the contents are
+        parsed as `char`s in an unknown encoding; use `as_utf8` (or
+        `decoded_utf32`) on a `mapped_file` to parse UTF-8 as code points. */
+    struct mapped_file
+    {
+        using iterator = char const *;
+
+        /** Constructs an empty `mapped_file`. */
+        mapped_file() = default;
+
+#if BOOST_PARSER_USE_EXCEPTIONS || defined(BOOST_PARSER_DOXYGEN)
+        /** Maps the file at `path`.  Throws `std::system_error` if the file
+            cannot be opened, or cannot be read.  Not available when
+            `BOOST_PARSER_NO_EXCEPTIONS` is defined. */
+        explicit mapped_file(char const * path)
+        {
+            std::error_code ec;
+            open(path, ec);
+            if (ec)
+                throw std::system_error(ec, path);
+        }
+
+        /** Maps the file at `path`.  Throws `std::system_error` if the file
+            cannot be opened, or cannot be read.  Not available when
+            `BOOST_PARSER_NO_EXCEPTIONS` is defined. */
+        explicit mapped_file(std::string const & path) :
+            mapped_file(path.c_str())
+        {}
+#endif
+
+        /** Maps the file at `path`.  If the file cannot be opened, or cannot
+            be read, `ec` is set to the reason why, and the `mapped_file` is
+            empty. */
+        mapped_file(char const * path, std::error_code & ec)
+        {
+            ec.clear();
+            open(path, ec);
+        }
+
+        /** Maps the file at `path`.  If the file cannot be opened, or cannot
+            be read, `ec` is set to the reason why, and the `mapped_file` is
+            empty. */
+        mapped_file(std::string const & path, std::error_code & ec) :
+            mapped_file(path.c_str(), ec)
+        {}
+
+        mapped_file(mapped_file && other) noexcept { swap(other); }
+
+        mapped_file & operator=(mapped_file && other) noexcept
+        {
+            mapped_file(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~mapped_file() { close(); }
+
+        iterator begin() const noexcept { return data_; }
+        iterator end() const noexcept { return data_ + size_; }
+        char const * data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return !size_; }
+
+        operator std::string_view() const noexcept
+        {
+            return std::string_view(data_, size_);
+        }
+
+        void swap(mapped_file & other) noexcept
+        {
+            // buf_ may be holding its chars in its small buffer, so data_
+            // must be re-pointed rather than swapped.
+            bool const this_mapped = mapped_;
+            bool const other_mapped = other.mapped_;
+            char const * const this_data = data_;
+            char const * const other_data = other.data_;
+            std::swap(size_, other.size_);
+            std::swap(mapped_, other.mapped_);
+            buf_.swap(other.buf_);
+            data_ = other_mapped ? other_data : buf_.data();
+            other.data_ = this_mapped ? this_data : other.buf_.data();
+        }
+
+    private:
+        void open(char const * path, std::error_code & ec)
+        {
+#if defined(BOOST_PARSER_MAPPED_FILE_POSIX)
+            int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                ec.assign(errno, std::generic_category());
+                return;
+            }
+            struct ::stat st;
+            if (::fstat(fd, &st) != 0) {
+                ec.assign(errno, std::generic_category());
+                ::close(fd);
+                return;
+            }
+            if (S_ISREG(st.st_mode)) {
+                map(fd, std::size_t(st.st_size), ec);
+            } else {
+                char chunk[1 << 16];
+                for (;;) {
+                    ::ssize_t const n = ::read(fd, chunk, sizeof(chunk));
+                    if (n < 0 && errno == EINTR)
+                        continue;
+                    if (n < 0) {
+                        ec.assign(errno, std::generic_category());
+                        buf_.clear();
+                        break;
+                    }
+                    if (!n)
+                        break;
+                    buf_.append(chunk, n);
+                }
+                data_ = buf_.data();
+                size_ = buf_.size();
+            }
+            ::close(fd);
+#else
+            std::ifstream ifs(path, std::ios_base::binary);
+            if (!ifs) {
+                ec = std::make_error_code(std::errc::no_such_file_or_directory);
+                return;
+            }
+            buf_.assign(
+                std::istreambuf_iterator<char>(ifs),
+                std::istreambuf_iterator<char>());
+            if (ifs.bad()) {
+                ec = std::make_error_code(std::errc::io_error);
+                buf_.clear();
+            }
+            data_ = buf_.data();
+            size_ = buf_.size();
+#endif
+        }
+
+#if defined(BOOST_PARSER_MAPPED_FILE_POSIX)
+        void map(int fd, std::size_t size, std::error_code & ec)
+        {
+            data_ = buf_.data();
+            if (!size)
+                return;
+            void * const p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ec.assign(errno, std::generic_category());
+                return;
+            }
+            // These are only hints; failure to take them is not an error.
+#if defined(MADV_SEQUENTIAL)
+            ::madvise(p, size, MADV_SEQUENTIAL);
+#endif
+#if defined(MADV_HUGEPAGE)
+            if (std::size_t(1) << 21 <= size)
+                ::madvise(p, size, MADV_HUGEPAGE);
+#endif
+            data_ = static_cast<char const *>(p);
+            size_ = size;
+            mapped_ = true;
+        }
+#endif
+
+        void close() noexcept
+        {
+#if defined(BOOST_PARSER_MAPPED_FILE_POSIX)
+            if (mapped_)
+                ::munmap(const_cast<char *>(data_), size_);
+#endif
+            mapped_ = false;
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        char const * data_ = nullptr;
+        std::size_t size_ = 0;
+        bool mapped_ = false;
+        std::string buf_;
+    };
+
+}
+
+#endif
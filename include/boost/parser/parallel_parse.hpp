@@ -0,0 +1,406 @@
+#ifndef BOOST_PARSER_PARALLEL_PARSE_HPP
+#define BOOST_PARSER_PARALLEL_PARSE_HPP
+
+#include <boost/parser/parser.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace boost::parser {
+
+    namespace detail {
+        template<typename T>
+        constexpr bool is_parser_interface_v = false;
+        template<typename Parser, typename GlobalState, typename ErrorHandler>
+        constexpr bool is_parser_interface_v<
+            parser_interface<Parser, GlobalState, ErrorHandler>> = true;
+
+        template<typename R>
+        auto contiguous_input(R const & r)
+        {
+            auto const first = std::data(r);
+            auto last = first + std::size(r);
+            if constexpr (std::is_array_v<R>) {
+                if (first != last && !*std::prev(last))
+                    --last;
+            }
+            return BOOST_PARSER_SUBRANGE(first, last);
+        }
+
+        // Returns the position just past the first match of `delimiter` at
+        // or after `it`, or `last` if there is none.
+        template<typename CharType, typename Delimiter>
+        CharType const * parallel_chunk_end(
+            CharType const * it,
+            CharType const * last,
+            Delimiter const & delimiter)
+        {
+            if constexpr (is_parser_interface_v<Delimiter>) {
+                for (; it != last; ++it) {
+                    CharType const * match_last = it;
+                    if (parser::prefix_parse(match_last, last, delimiter) &&
+                        match_last != it) {
+                        return match_last;
+                    }
+                }
+                return last;
+            } else {
+                it = std::find(it, last, delimiter);
+                return it == last ? last : std::next(it);
+            }
+        }
+
+        // Divides `[first, last)` into at most `chunks` pieces of roughly
+        // equal size, each of which ends just past a delimiter, or at
+        // `last`.  There is always at least one piece, even if it is empty.
+        template<typename CharType, typename Delimiter>
+        std::vector<BOOST_PARSER_SUBRANGE<CharType const *>> parallel_chunks(
+            CharType const * first,
+            CharType const * last,
+            Delimiter const & delimiter,
+            std::size_t chunks)
+        {
+            std::vector<BOOST_PARSER_SUBRANGE<CharType const *>> retval;
+            std::size_t const size = last - first;
+            CharType const * chunk_first = first;
+            for (std::size_t i = 1; i < chunks && chunk_first != last; ++i) {
+                CharType const * const target = first + size * i / chunks;
+                CharType const * const chunk_last = detail::parallel_chunk_end(
+                    (std::max)(target, chunk_first), last, delimiter);
+                retval.push_back(
+                    BOOST_PARSER_SUBRANGE(chunk_first, chunk_last));
+                chunk_first = chunk_last;
+            }
+            if (retval.empty() || chunk_first != last)
+                retval.push_back(BOOST_PARSER_SUBRANGE(chunk_first, last));
+            return retval;
+        }
+
+        inline std::size_t parallel_chunk_count(std::size_t threads, std::size_t size)
+        {
+            if (threads)
+                return threads;
+            // Don't bother starting a thread for less than this much input.
+            std::size_t const min_chunk_size = 1 << 16;
+            std::size_t const hardware_threads =
+                (std::max)(std::thread::hardware_concurrency(), 1u);
+            return (std::max)(
+                (std::min)(hardware_threads, size / min_chunk_size),
+                std::size_t(1));
+        }
+
+        // Calls f(i) for each i in [0, n), each on its own thread, and
+        // rethrows the first exception thrown by any of the calls, if any.
+        template<typename F>
+        void parallel_for(std::size_t n, F const & f)
+        {
+#if BOOST_PARSER_USE_EXCEPTIONS
+            std::vector<std::exception_ptr> exceptions(n);
+            auto const g = [&](std::size_t i) {
+                try {
+                    f(i);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            };
+#else
+            auto const & g = f;
+#endif
+            std::vector<std::thread> threads;
+            threads.reserve(n);
+            for (std::size_t i = 1; i < n; ++i) {
+                threads.emplace_back(g, i);
+            }
+            g(0);
+            for (auto & thread : threads) {
+                thread.join();
+            }
+#if BOOST_PARSER_USE_EXCEPTIONS
+            for (auto const & e : exceptions) {
+                if (e)
+                    std::rethrow_exception(e);
+            }
+#endif
+        }
+
+        // Passes the errors and diagnostics from the parse of one chunk on
+        // to `error_handler_`, as if they came from a parse of the whole
+        // input, so that the positions it reports (such as line numbers) are
+        // positions in the whole input, not in the chunk.
+        template<typename ErrorHandler, typename Iter>
+        struct chunk_error_handler
+        {
+            template<typename Sentinel, typename Error>
+            auto operator()(Iter, Sentinel, Error const & e) const
+                -> decltype(std::declval<ErrorHandler const &>()(
+                    std::declval<Iter>(), std::declval<Iter>(), e))
+            {
+                return error_handler_(first_, last_, e);
+            }
+
+            template<typename Context, typename I>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context,
+                I it) const
+            {
+                auto input_context = context;
+                input_context.first_ = first_;
+                input_context.last_ = last_;
+                error_handler_.diagnose(kind, message, input_context, it);
+            }
+
+            template<typename Context>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context) const
+            {
+                diagnose(
+                    kind, message, context, parser::_where(context).begin());
+            }
+
+            ErrorHandler const & error_handler_;
+            Iter first_;
+            Iter last_;
+        };
+
+        // Calls f with a parser like `parser`, but with its own copy of
+        // `parser`'s globals, and with `error_handler` in place of its error
+        // handler.
+        template<
+            typename Parser,
+            typename GlobalState,
+            typename ErrorHandler,
+            typename ChunkErrorHandler,
+            typename F>
+        decltype(auto) with_own_globals(
+            parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+            ChunkErrorHandler const & error_handler,
+            F const & f)
+        {
+            if constexpr (std::is_reference_v<GlobalState>) {
+                remove_cv_ref_t<GlobalState> globals = parser.globals_;
+                return f(parser_interface<
+                         Parser,
+                         remove_cv_ref_t<GlobalState> &,
+                         ChunkErrorHandler const &>{
+                    parser.parser_, globals, error_handler});
+            } else {
+                return f(parser_interface<
+                         Parser,
+                         GlobalState,
+                         ChunkErrorHandler const &>{
+                    parser.parser_, parser.globals_, error_handler});
+            }
+        }
+
+        template<
+            typename R,
+            typename Delimiter,
+            typename Parser,
+            typename GlobalState,
+            typename ErrorHandler,
+            typename Parse>
+        auto parallel_parse_impl(
+            R const & r,
+            Delimiter const & delimiter,
+            parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+            std::size_t threads,
+            Parse const & parse_chunk)
+        {
+            auto const input = detail::contiguous_input(r);
+            auto const chunks = detail::parallel_chunks(
+                input.begin(),
+                input.end(),
+                delimiter,
+                detail::parallel_chunk_count(threads, input.size()));
+
+            chunk_error_handler<
+                remove_cv_ref_t<ErrorHandler>,
+                decltype(input.begin())> const error_handler{
+                parser.error_handler_, input.begin(), input.end()};
+
+            using result_type =
+                decltype(parse_chunk(chunks.front(), parser));
+            // Not a std::vector, since that would be a std::vector<bool> for
+            // parsers without attributes.
+            std::unique_ptr<result_type[]> const results(
+                new result_type[chunks.size()]());
+            detail::parallel_for(chunks.size(), [&](std::size_t i) {
+                results[i] = detail::with_own_globals(
+                    parser, error_handler, [&](auto const & p) {
+                        return parse_chunk(chunks[i], p);
+                    });
+            });
+
+            if constexpr (std::is_same_v<result_type, bool>) {
+                return std::all_of(
+                    results.get(),
+                    results.get() + chunks.size(),
+                    [](bool b) { return b; });
+            } else {
+                using attr_type = typename result_type::value_type;
+                static_assert(
+                    container<attr_type>,
+                    "parallel_parse() concatenates the attributes produced "
+                    "for each chunk of the input, so the parser's attribute "
+                    "must be a container, such as the std::vector produced "
+                    "by *record.");
+                result_type retval;
+                for (std::size_t i = 0; i < chunks.size(); ++i) {
+                    auto & result = results[i];
+                    if (!result)
+                        return result_type();
+                    if (!retval) {
+                        retval = std::move(result);
+                    } else {
+                        retval->insert(
+                            retval->end(),
+                            std::make_move_iterator(result->begin()),
+                            std::make_move_iterator(result->end()));
+                    }
+                }
+                return retval;
+            }
+        }
+    }
+
+    /** Parses `r` using `parser`, on as many threads as there are chunks of
+        the input.  `r` must be a contiguous range, such as a `std::string`,
+        `std::string_view` or `mapped_file`.
+
+        `r` is divided into `threads` chunks of roughly equal size (or, if
+        `threads` is `0`, into one chunk per hardware thread, with at least
+        64KB per chunk).  Each chunk ends just after a match of `delimiter`,
+        which is either a character, such as `'\n'`, or a parser; the search
+        for it begins at the nominal end of the chunk, so `delimiter` must
+        not match inside a record.  Each chunk is parsed with `parse(chunk,
+        parser)`, so `parser` must match a sequence of whole records, and
+        each chunk is parsed with its own copy of `parser`'s globals.  The
+        error handler is shared by all the threads.  It is given the whole
+        of `r` as the input, so the positions it reports are positions in
+        `r`; however, `_begin()` and `_end()` in semantic actions are the
+        bounds of the chunk being parsed.
+
+        If any chunk fails to parse, the result is `std::nullopt` (or `false`
+        if `parser` has no attribute).  Otherwise, the attribute produced is
+        the chunks' attributes, concatenated in order; this is the same as the
+        attribute produced by `parse(r, parser)`. */
+    template<
+        typename R,
+        typename Delimiter,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler>
+    auto parallel_parse(
+        R const & r,
+        Delimiter const & delimiter,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        std::size_t threads = 0)
+    {
+        return detail::parallel_parse_impl(
+            r, delimiter, parser, threads, [](auto chunk, auto const & p) {
+                return boost::parser::parse(chunk, p);
+            });
+    }
+
+    /** Parses `r` using `parser`, skipping all input recognized by `skip`
+        between the application of any two parsers, on as many threads as
+        there are chunks of the input.  Otherwise, the same as the overload
+        without `skip`. */
+    template<
+        typename R,
+        typename Delimiter,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser>
+    auto parallel_parse(
+        R const & r,
+        Delimiter const & delimiter,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        parser_interface<SkipParser> const & skip,
+        std::size_t threads = 0)
+    {
+        return detail::parallel_parse_impl(
+            r,
+            delimiter,
+            parser,
+            threads,
+            [&skip](auto chunk, auto const & p) {
+                return boost::parser::parse(chunk, p, skip);
+            });
+    }
+
+    /** Parses `r` using `parser`, calling `callbacks` for the callback rules
+        that match, on as many threads as there are chunks of the input.
+        `callbacks` is called concurrently from all of the threads, so it
+        must be safe to do so; within each chunk, the calls are made in order.
+        Returns `true` if every chunk parsed successfully.  The input is
+        divided into chunks as for `parallel_parse()`. */
+    template<
+        typename R,
+        typename Delimiter,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename Callbacks>
+    bool parallel_callback_parse(
+        R const & r,
+        Delimiter const & delimiter,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        Callbacks const & callbacks,
+        std::size_t threads = 0)
+    {
+        return detail::parallel_parse_impl(
+            r,
+            delimiter,
+            parser,
+            threads,
+            [&callbacks](auto chunk, auto const & p) {
+                return boost::parser::callback_parse(chunk, p, callbacks);
+            });
+    }
+
+    /** Parses `r` using `parser`, skipping all input recognized by `skip`
+        between the application of any two parsers, and calling `callbacks`
+        for the callback rules that match, on as many threads as there are
+        chunks of the input.  Otherwise, the same as the overload without
+        `skip`. */
+    template<
+        typename R,
+        typename Delimiter,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser,
+        typename Callbacks>
+    bool parallel_callback_parse(
+        R const & r,
+        Delimiter const & delimiter,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        parser_interface<SkipParser> const & skip,
+        Callbacks const & callbacks,
+        std::size_t threads = 0)
+    {
+        return detail::parallel_parse_impl(
+            r,
+            delimiter,
+            parser,
+            threads,
+            [&](auto chunk, auto const & p) {
+                return boost::parser::callback_parse(
+                    chunk, p, skip, callbacks);
+            });
+    }
+
+}
+
+#endif
@@ -8,11 +8,19 @@
 
 #include <boost/parser/parser_fwd.hpp>
 #include <boost/parser/concepts.hpp>
+#include <boost/parser/decoded_utf32.hpp>
 #include <boost/parser/error_handling.hpp>
 #include <boost/parser/tuple.hpp>
 #include <boost/parser/detail/hl.hpp>
 #include <boost/parser/detail/numeric.hpp>
+#include <boost/parser/detail/ascii_no_case.hpp>
 #include <boost/parser/detail/case_fold.hpp>
+#include <boost/parser/detail/code_point_set.hpp>
+#include <boost/parser/detail/contiguous.hpp>
+#include <boost/parser/detail/fast_int.hpp>
+#include <boost/parser/detail/fast_real.hpp>
+#include <boost/parser/detail/flat_trie.hpp>
+#include <boost/parser/detail/skip_ws.hpp>
 #include <boost/parser/detail/unicode_char_sets.hpp>
 #include <boost/parser/detail/pp_for_each.hpp>
 #include <boost/parser/detail/printing.hpp>
@@ -21,7 +29,12 @@
 #include <boost/parser/detail/text/trie.hpp>
 #include <boost/parser/detail/text/unpack.hpp>
 
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#include <cstring>
 #include <type_traits>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -428,7 +441,10 @@ namespace boost { namespace parser {
             typename RuleTag = void,
             typename RuleLocals = nope,
             typename RuleParams = nope,
-            typename Where = nope>
+            typename Where = nope,
+            bool DoTrace = false,
+            bool ViewAttrs = false,
+            bool NoCase = false>
         struct parse_context
         {
             parse_context() = default;
@@ -437,6 +453,20 @@ namespace boost { namespace parser {
 
             using rule_tag = RuleTag;
 
+            // When false, no trace objects are created during the parse at
+            // all; see scoped_trace().
+            static constexpr bool do_trace = DoTrace;
+
+            // When true, we are inside views[], and repetitions of character
+            // parsers over contiguous chars produce string_views; see
+            // detail::yields_string_view.
+            static constexpr bool view_attrs = ViewAttrs;
+
+            // When true, we are inside no_case[].  Since this is part of the
+            // type, parsers outside of no_case[] compare exactly, without
+            // checking at each character; see detail::make_no_case_context.
+            static constexpr bool no_case = NoCase;
+
             I first_;
             S last_;
             bool * pass_ = nullptr;
@@ -450,7 +480,9 @@ namespace boost { namespace parser {
             nope_or_pointer_t<RuleLocals> locals_{};
             nope_or_pointer_t<RuleParams, true> params_{};
             nope_or_pointer_t<Where, true> where_{};
-            int no_case_depth_ = 0;
+            // Set once an expectation failure has been passed to the error
+            // handler without throwing; see detail::expectation_failed().
+            bool * expectation_failed_ = nullptr;
 
             template<typename T>
             static auto nope_or_address(T & x)
@@ -528,7 +560,11 @@ namespace boost { namespace parser {
                     OldVal,
                     OldRuleTag,
                     OldRuleLocals,
-                    OldRuleParams> const & other,
+                    OldRuleParams,
+                    nope,
+                    DoTrace,
+                    ViewAttrs,
+                    NoCase> const & other,
                 NewRuleTag * tag_ptr,
                 NewVal & value,
                 NewRuleLocals & locals,
@@ -542,7 +578,7 @@ namespace boost { namespace parser {
                 globals_(other.globals_),
                 callbacks_(other.callbacks_),
                 attr_(other.attr_),
-                no_case_depth_(other.no_case_depth_)
+                expectation_failed_(other.expectation_failed_)
             {
                 if constexpr (
                     std::is_same_v<OldRuleTag, NewRuleTag> &&
@@ -571,7 +607,10 @@ namespace boost { namespace parser {
                     RuleTag,
                     RuleLocals,
                     RuleParams,
-                    OldWhere> const & other,
+                    OldWhere,
+                    DoTrace,
+                    ViewAttrs,
+                    NoCase> const & other,
                 Attr & attr,
                 Where const & where) :
                 first_(other.first_),
@@ -587,7 +626,73 @@ namespace boost { namespace parser {
                 locals_(other.locals_),
                 params_(other.params_),
                 where_(nope_or_address(where)),
-                no_case_depth_(other.no_case_depth_)
+                expectation_failed_(other.expectation_failed_)
+            {}
+
+            // For entering views[].
+            parse_context(
+                parse_context<
+                    I,
+                    S,
+                    ErrorHandler,
+                    GlobalState,
+                    Callbacks,
+                    Attr,
+                    Val,
+                    RuleTag,
+                    RuleLocals,
+                    RuleParams,
+                    Where,
+                    DoTrace,
+                    !ViewAttrs,
+                    NoCase> const & other) :
+                first_(other.first_),
+                last_(other.last_),
+                pass_(other.pass_),
+                trace_indent_(other.trace_indent_),
+                symbol_table_tries_(other.symbol_table_tries_),
+                error_handler_(other.error_handler_),
+                globals_(other.globals_),
+                callbacks_(other.callbacks_),
+                attr_(other.attr_),
+                val_(other.val_),
+                locals_(other.locals_),
+                params_(other.params_),
+                where_(other.where_),
+                expectation_failed_(other.expectation_failed_)
+            {}
+
+            // For entering no_case[].
+            parse_context(
+                parse_context<
+                    I,
+                    S,
+                    ErrorHandler,
+                    GlobalState,
+                    Callbacks,
+                    Attr,
+                    Val,
+                    RuleTag,
+                    RuleLocals,
+                    RuleParams,
+                    Where,
+                    DoTrace,
+                    ViewAttrs,
+                    !NoCase> const & other) :
+                first_(other.first_),
+                last_(other.last_),
+                pass_(other.pass_),
+                trace_indent_(other.trace_indent_),
+                symbol_table_tries_(other.symbol_table_tries_),
+                error_handler_(other.error_handler_),
+                globals_(other.globals_),
+                callbacks_(other.callbacks_),
+                attr_(other.attr_),
+                val_(other.val_),
+                locals_(other.locals_),
+                params_(other.params_),
+                where_(other.where_),
+                expectation_failed_(other.expectation_failed_)
             {}
         };
 
@@ -603,7 +708,10 @@ namespace boost { namespace parser {
             typename RuleParams,
             typename Attr,
             typename Where,
-            typename OldAttr>
+            typename OldAttr,
+            bool DoTrace,
+            bool ViewAttrs,
+            bool NoCase>
         auto make_action_context(
             parse_context<
                 I,
@@ -615,7 +723,11 @@ namespace boost { namespace parser {
                 Val,
                 RuleTag,
                 RuleLocals,
-                RuleParams> const & context,
+                RuleParams,
+                nope,
+                DoTrace,
+                ViewAttrs,
+                NoCase> const & context,
             Attr & attr,
             Where const & where)
         {
@@ -630,7 +742,10 @@ namespace boost { namespace parser {
                 RuleTag,
                 RuleLocals,
                 RuleParams,
-                Where>;
+                Where,
+                DoTrace,
+                ViewAttrs,
+                NoCase>;
             return result_type(context, attr, where);
         }
 
@@ -648,7 +763,10 @@ namespace boost { namespace parser {
             typename NewVal,
             typename NewRuleTag,
             typename NewRuleLocals,
-            typename NewRuleParams>
+            typename NewRuleParams,
+            bool DoTrace,
+            bool ViewAttrs,
+            bool NoCase>
         auto make_rule_context(
             parse_context<
                 I,
@@ -660,7 +778,11 @@ namespace boost { namespace parser {
                 Val,
                 RuleTag,
                 RuleLocals,
-                RuleParams> const & context,
+                RuleParams,
+                nope,
+                DoTrace,
+                ViewAttrs,
+                NoCase> const & context,
             NewRuleTag * tag_ptr,
             NewVal & value,
             NewRuleLocals & locals,
@@ -682,11 +804,125 @@ namespace boost { namespace parser {
                 std::conditional_t<
                     std::is_same_v<NewRuleParams, nope>,
                     RuleParams,
-                    NewRuleParams>>;
+                    NewRuleParams>,
+                nope,
+                DoTrace,
+                ViewAttrs,
+                NoCase>;
             return result_type(context, tag_ptr, value, locals, params);
         }
 
-        template<typename Iter, typename Sentinel, typename ErrorHandler>
+        template<
+            typename I,
+            typename S,
+            typename ErrorHandler,
+            typename GlobalState,
+            typename Callbacks,
+            typename Attr,
+            typename Val,
+            typename RuleTag,
+            typename RuleLocals,
+            typename RuleParams,
+            typename Where,
+            bool DoTrace,
+            bool ViewAttrs,
+            bool NoCase>
+        auto make_view_attrs_context(parse_context<
+                                     I,
+                                     S,
+                                     ErrorHandler,
+                                     GlobalState,
+                                     Callbacks,
+                                     Attr,
+                                     Val,
+                                     RuleTag,
+                                     RuleLocals,
+                                     RuleParams,
+                                     Where,
+                                     DoTrace,
+                                     ViewAttrs,
+                                     NoCase> const & context)
+        {
+            if constexpr (ViewAttrs) {
+                return context;
+            } else {
+                using result_type = parse_context<
+                    I,
+                    S,
+                    ErrorHandler,
+                    GlobalState,
+                    Callbacks,
+                    Attr,
+                    Val,
+                    RuleTag,
+                    RuleLocals,
+                    RuleParams,
+                    Where,
+                    DoTrace,
+                    true,
+                    NoCase>;
+                return result_type(context);
+            }
+        }
+
+        template<
+            typename I,
+            typename S,
+            typename ErrorHandler,
+            typename GlobalState,
+            typename Callbacks,
+            typename Attr,
+            typename Val,
+            typename RuleTag,
+            typename RuleLocals,
+            typename RuleParams,
+            typename Where,
+            bool DoTrace,
+            bool ViewAttrs,
+            bool NoCase>
+        auto make_no_case_context(parse_context<
+                                  I,
+                                  S,
+                                  ErrorHandler,
+                                  GlobalState,
+                                  Callbacks,
+                                  Attr,
+                                  Val,
+                                  RuleTag,
+                                  RuleLocals,
+                                  RuleParams,
+                                  Where,
+                                  DoTrace,
+                                  ViewAttrs,
+                                  NoCase> const & context)
+        {
+            if constexpr (NoCase) {
+                return context;
+            } else {
+                using result_type = parse_context<
+                    I,
+                    S,
+                    ErrorHandler,
+                    GlobalState,
+                    Callbacks,
+                    Attr,
+                    Val,
+                    RuleTag,
+                    RuleLocals,
+                    RuleParams,
+                    Where,
+                    DoTrace,
+                    ViewAttrs,
+                    true>;
+                return result_type(context);
+            }
+        }
+
+        template<
+            bool DoTrace,
+            typename Iter,
+            typename Sentinel,
+            typename ErrorHandler>
         auto make_context(
             Iter first,
             Sentinel last,
@@ -696,7 +932,20 @@ namespace boost { namespace parser {
             nope & n,
             symbol_table_tries_t & symbol_table_tries) noexcept
         {
-            return parse_context(
+            using context_t = parse_context<
+                Iter,
+                Sentinel,
+                ErrorHandler,
+                nope,
+                nope,
+                nope,
+                nope,
+                void,
+                nope,
+                nope,
+                nope,
+                DoTrace>;
+            return context_t(
                 first,
                 last,
                 success,
@@ -707,6 +956,7 @@ namespace boost { namespace parser {
         }
 
         template<
+            bool DoTrace = false,
             typename Iter,
             typename Sentinel,
             typename ErrorHandler,
@@ -720,7 +970,20 @@ namespace boost { namespace parser {
             GlobalState & globals,
             symbol_table_tries_t & symbol_table_tries) noexcept
         {
-            return parse_context(
+            using context_t = parse_context<
+                Iter,
+                Sentinel,
+                ErrorHandler,
+                GlobalState,
+                nope,
+                nope,
+                nope,
+                void,
+                nope,
+                nope,
+                nope,
+                DoTrace>;
+            return context_t(
                 first,
                 last,
                 success,
@@ -731,6 +994,7 @@ namespace boost { namespace parser {
         }
 
         template<
+            bool DoTrace = false,
             typename Iter,
             typename Sentinel,
             typename ErrorHandler,
@@ -745,7 +1009,20 @@ namespace boost { namespace parser {
             nope & n,
             symbol_table_tries_t & symbol_table_tries) noexcept
         {
-            return parse_context(
+            using context_t = parse_context<
+                Iter,
+                Sentinel,
+                ErrorHandler,
+                nope,
+                Callbacks,
+                nope,
+                nope,
+                void,
+                nope,
+                nope,
+                nope,
+                DoTrace>;
+            return context_t(
                 first,
                 last,
                 success,
@@ -757,6 +1034,7 @@ namespace boost { namespace parser {
         }
 
         template<
+            bool DoTrace = false,
             typename Iter,
             typename Sentinel,
             typename ErrorHandler,
@@ -772,7 +1050,20 @@ namespace boost { namespace parser {
             GlobalState & globals,
             symbol_table_tries_t & symbol_table_tries) noexcept
         {
-            return parse_context(
+            using context_t = parse_context<
+                Iter,
+                Sentinel,
+                ErrorHandler,
+                GlobalState,
+                Callbacks,
+                nope,
+                nope,
+                void,
+                nope,
+                nope,
+                nope,
+                DoTrace>;
+            return context_t(
                 first,
                 last,
                 success,
@@ -783,7 +1074,6 @@ namespace boost { namespace parser {
                 symbol_table_tries);
         }
 
-
         template<unsigned int I>
         struct param_t
         {
@@ -878,24 +1168,234 @@ namespace boost { namespace parser {
             return *context.callbacks_;
         }
 
+        /** The elements of a symbol table as of some point, and the tries
+            for looking them up, each built on first use.  A top-level parse
+            uses one snapshot for the whole parse. */
+        template<typename T>
+        struct symbol_table_snapshot
+        {
+            explicit symbol_table_snapshot(
+                std::vector<std::pair<std::string_view, T>> elements) :
+                elements_(std::move(elements))
+            {}
+
+            flat_trie<T> const & trie() const { return trie_.get(elements_); }
+            flat_trie<T, true> const & no_case_trie() const
+            {
+                return no_case_trie_.get(elements_);
+            }
+
+            std::vector<std::pair<std::string_view, T>> const elements_;
+
+        private:
+            lazy_flat_trie<T> trie_;
+            lazy_flat_trie<T, true> no_case_trie_;
+        };
+
+        /** The elements of a symbol table, each stamped with the
+            `symbol_table_generation` at which it was added, and a snapshot
+            of all of them that is shared by parses until the next element
+            is added.  Adding an element never disturbs a snapshot that a
+            parse is using.  Copies start out with no snapshot. */
+        template<typename T>
+        struct symbol_table_elements
+        {
+            using snapshot_ptr =
+                std::shared_ptr<symbol_table_snapshot<T> const>;
+
+            symbol_table_elements() = default;
+            symbol_table_elements(symbol_table_elements const & other) :
+                elements_(other.elements_), generations_(other.generations_)
+            {}
+            symbol_table_elements &
+            operator=(symbol_table_elements const & other)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                elements_ = other.elements_;
+                generations_ = other.generations_;
+                snapshot_.reset();
+                return *this;
+            }
+
+            void assign(std::vector<std::pair<std::string_view, T>> elements)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                elements_ = std::move(elements);
+                generations_.assign(elements_.size(), 0);
+                snapshot_.reset();
+            }
+
+            void insert(std::string_view str, T x)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                elements_.push_back(
+                    std::pair<std::string_view, T>(str, std::move(x)));
+                generations_.push_back(++symbol_table_generation);
+                snapshot_.reset();
+            }
+
+            /** Returns the elements added no later than `generation`.
+                Unless elements were added during the parse asking for
+                them, these are all the elements. */
+            snapshot_ptr snapshot(std::uint64_t generation) const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::size_t const n =
+                    std::upper_bound(
+                        generations_.begin(), generations_.end(), generation) -
+                    generations_.begin();
+                if (snapshot_ && snapshot_->elements_.size() == n)
+                    return snapshot_;
+                auto retval = std::make_shared<symbol_table_snapshot<T> const>(
+                    std::vector<std::pair<std::string_view, T>>(
+                        elements_.begin(), elements_.begin() + n));
+                if (n == elements_.size())
+                    snapshot_ = retval;
+                return retval;
+            }
+
+            std::vector<std::pair<std::string_view, T>> const &
+            elements() const noexcept
+            {
+                return elements_;
+            }
+
+        private:
+            std::vector<std::pair<std::string_view, T>> elements_;
+            std::vector<std::uint64_t> generations_;
+            mutable snapshot_ptr snapshot_;
+            mutable std::mutex mutex_;
+        };
+
+        /** The copy of a symbol table that a parse makes when it first
+            mutates the table. */
+        template<typename T>
+        struct parse_local_symbols
+        {
+            using trie_t = text::trie<std::vector<char32_t>, T>;
+
+            explicit parse_local_symbols(
+                std::vector<std::pair<std::string_view, T>> const &
+                    initial_elements)
+            {
+                for (auto const & e : initial_elements) {
+                    if (trie_.insert(e.first | text::as_utf32, e.second))
+                        keys_.emplace_back(e.first);
+                }
+            }
+
+            void insert(std::string_view str, T x)
+            {
+                if (no_case_trie_)
+                    no_case_trie_->insert(detail::case_folded_key(str), x);
+                if (trie_.insert(str | text::as_utf32, std::move(x)))
+                    keys_.emplace_back(str);
+            }
+
+            void erase(std::string_view str)
+            {
+                if (!trie_.erase(str | text::as_utf32))
+                    return;
+                keys_.erase(std::find(keys_.begin(), keys_.end(), str));
+                if (!no_case_trie_)
+                    return;
+                // The folded key may still be shared by an entry with
+                // different case; if so, it now maps to the earliest one.
+                auto const folded = detail::case_folded_key(str);
+                no_case_trie_->erase(folded);
+                for (auto const & key : keys_) {
+                    if (detail::case_folded_key(key) == folded) {
+                        no_case_trie_->insert(
+                            folded, *trie_[key | text::as_utf32]);
+                        break;
+                    }
+                }
+            }
+
+            /** Returns the entries of the table, with their keys case
+                folded, building them on first use.  Where several keys fold
+                to the same key, the earliest inserted one is used. */
+            trie_t const & no_case_trie()
+            {
+                if (!no_case_trie_) {
+                    no_case_trie_ = trie_t{};
+                    for (auto const & key : keys_) {
+                        no_case_trie_->insert(
+                            detail::case_folded_key(key),
+                            *trie_[key | text::as_utf32]);
+                    }
+                }
+                return *no_case_trie_;
+            }
+
+            trie_t trie_;
+
+        private:
+            // The keys in trie_, in the order they were inserted.
+            std::vector<std::string> keys_;
+            // Most parses never look the table up under no_case[], so the
+            // case folded copy is only built when one does.
+            std::optional<trie_t> no_case_trie_;
+        };
+
+        /** The state of a symbol table during one top-level parse: the
+            snapshot of the table's elements that the parse first used, and
+            the copy that the parse makes if it mutates the table. */
+        template<typename T>
+        struct parse_symbol_table
+        {
+            std::shared_ptr<symbol_table_snapshot<T> const> snapshot_;
+            std::optional<parse_local_symbols<T>> local_;
+        };
+
         template<typename Context, typename T>
-        decltype(auto) get_trie(
+        auto & get_parse_symbol_table(
             Context const & context, symbol_parser<T> const & symbol_parser)
         {
-            using trie_t = text::trie<std::vector<char32_t>, T>;
             symbol_table_tries_t & symbol_table_tries =
                 *context.symbol_table_tries_;
             any_copyable & a = symbol_table_tries[(void *)&symbol_parser];
             if (a.empty()) {
-                a = trie_t{};
-                trie_t & trie = a.cast<trie_t>();
-                for (auto const & e : symbol_parser.initial_elements()) {
-                    trie.insert(e.first | text::as_utf32, e.second);
-                }
-                return trie;
-            } else {
-                return a.cast<trie_t>();
+                a = parse_symbol_table<T>{
+                    symbol_parser.elements_.snapshot(
+                        symbol_table_tries.generation_),
+                    std::nullopt};
+            }
+            return a.cast<parse_symbol_table<T>>();
+        }
+
+        template<typename Context, typename T>
+        auto & get_mutable_symbols(
+            Context const & context, symbol_parser<T> const & symbol_parser)
+        {
+            auto & table =
+                detail::get_parse_symbol_table(context, symbol_parser);
+            if (!table.local_)
+                table.local_.emplace(table.snapshot_->elements_);
+            return *table.local_;
+        }
+
+        /** Returns the longest prefix of `[first, last)` whose case folding
+            is a key in `trie`, whose keys are case folded.  The prefix ends
+            at the iterator returned with the match. */
+        template<typename Trie, typename Iter, typename Sentinel>
+        auto no_case_longest_match(Trie const & trie, Iter first, Sentinel last)
+        {
+            auto prev = trie.longest_match(first, first);
+            auto retval = std::pair(prev, first);
+            for (; first != last; ++first) {
+                char32_t folded[longest_mapping];
+                char32_t const * const folded_last =
+                    detail::case_fold(*first, folded);
+                auto const next =
+                    trie.extend_subsequence(prev, folded, folded_last);
+                if (next.size - prev.size != folded_last - folded)
+                    break;
+                prev = next;
+                if (prev.match)
+                    retval = std::pair(prev, std::next(first));
             }
+            return retval;
         }
 
 
@@ -931,6 +1431,41 @@ namespace boost { namespace parser {
         constexpr bool is_unconditional_eps_v =
             is_unconditional_eps<remove_cv_ref_t<T>>::value;
 
+        // True iff Parser matches exactly one element of the input, and
+        // produces that element as its attribute.  p - q is !q >> p, so it
+        // is included when p is.
+        template<typename Parser>
+        constexpr bool is_single_char_parser_v = false;
+        template<typename Expected, typename AttributeType>
+        constexpr bool
+            is_single_char_parser_v<char_parser<Expected, AttributeType>> =
+                true;
+        template<typename Tag>
+        constexpr bool is_single_char_parser_v<char_set_parser<Tag>> = true;
+        template<typename Tag>
+        constexpr bool is_single_char_parser_v<char_subrange_parser<Tag>> =
+            true;
+        template<>
+        inline constexpr bool is_single_char_parser_v<digit_parser> = true;
+
+        template<typename Parser>
+        constexpr bool is_negated_lookahead_v = false;
+        template<typename Parser>
+        constexpr bool is_negated_lookahead_v<expect_parser<Parser, true>> =
+            true;
+
+        template<
+            typename... Parsers,
+            typename BacktrackingTuple,
+            typename CombiningGroups>
+        constexpr bool is_single_char_parser_v<
+            seq_parser<tuple<Parsers...>, BacktrackingTuple, CombiningGroups>> =
+            (is_negated_lookahead_v<Parsers> + ... + 0) + 1 ==
+                sizeof...(Parsers) &&
+            is_single_char_parser_v<std::tuple_element_t<
+                sizeof...(Parsers) - 1,
+                std::tuple<Parsers...>>>;
+
         template<typename T>
         struct is_zero_plus_p : std::false_type
         {};
@@ -1371,6 +1906,57 @@ namespace boost { namespace parser {
         struct null_parser
         {};
 
+        // Inside lexeme[] within views[], this is passed in place of the
+        // skipper, so that the parsers there can tell from its type that
+        // nothing is skipped.  skip[] unwraps it again.
+        template<typename SkipParser>
+        struct lexeme_skipper
+        {
+            template<typename... Args>
+            auto operator()(Args &&... args) const
+            {
+                return skip_((Args &&) args...);
+            }
+
+            SkipParser const & skip_;
+        };
+
+        template<typename SkipParser>
+        constexpr bool is_lexeme_skipper_v = false;
+        template<typename SkipParser>
+        constexpr bool is_lexeme_skipper_v<lexeme_skipper<SkipParser>> = true;
+
+        // Returns the skipper that skip[] without a skip parser of its own
+        // re-enables.
+        template<typename SkipParser>
+        decltype(auto) outer_skipper(SkipParser const & skip)
+        {
+            if constexpr (is_lexeme_skipper_v<SkipParser>)
+                return skip.skip_;
+            else
+                return skip;
+        }
+
+        // True iff a repetition of Parser should produce a string_view of
+        // the matched input, rather than a container.  That happens only
+        // within views[], when parsing contiguous chars, and only for
+        // undelimited repetitions of a parser that matches one char, and
+        // where nothing is skipped, so that the match is exactly the text
+        // of the chars that the container would hold.
+        template<
+            typename Context,
+            typename Iter,
+            typename SkipParser,
+            typename Parser,
+            typename Attr,
+            typename DelimiterParser = nope>
+        constexpr bool yields_string_view_v =
+            Context::view_attrs && is_contiguous_char_iter_v<Iter> &&
+            std::is_same_v<Attr, char> && is_nope_v<DelimiterParser> &&
+            is_single_char_parser_v<Parser> &&
+            (std::is_same_v<SkipParser, null_parser> ||
+             is_lexeme_skipper_v<SkipParser>);
+
         struct skip_skipper
         {
             template<
@@ -1410,30 +1996,190 @@ namespace boost { namespace parser {
             {}
         };
 
-        template<typename Iter, typename Sentinel>
-        void
-        skip(Iter & first, Sentinel last, null_parser const & skip_, flags f)
-        {}
+        // True when expectation failures are passed to the error handler as
+        // an expectation_failure, without throwing.  That happens when the
+        // error handler can take one, and always when exceptions are off.
+        template<typename Context>
+        constexpr bool expectation_failure_status_v =
+            !BOOST_PARSER_USE_EXCEPTIONS ||
+            std::is_invocable_v<
+                remove_cv_ref_t<decltype(*std::declval<Context>().error_handler_)>
+                    const &,
+                decltype(std::declval<Context>().first_),
+                decltype(std::declval<Context>().last_),
+                expectation_failure<decltype(std::declval<Context>().first_)>
+                    const &>;
+
+        // Returns true if an expectation failure has already been handled
+        // without throwing.  The parse must then fail, so the parsers that
+        // would otherwise recover from a failure (alternatives, repetitions,
+        // optionals, and negated predicates) check this first.
+        template<typename Context>
+        bool expectation_failed(Context const & context)
+        {
+            if constexpr (expectation_failure_status_v<Context>) {
+                return context.expectation_failed_ &&
+                       *context.expectation_failed_;
+            } else {
+                return false;
+            }
+        }
 
-        template<typename Iter, typename Sentinel, typename SkipParser>
-        void
-        skip(Iter & first, Sentinel last, SkipParser const & skip_, flags f)
+        template<typename Context, typename Parser>
+        void print_expected_parser(
+            void const * parser, void const * context, std::ostream & os)
         {
-            if (!detail::use_skip(f))
-                return;
-            bool success = true;
-            int indent = 0;
-            rethrow_error_handler eh;
-            nope n;
-            symbol_table_tries_t symbol_table_tries;
-            auto const context = detail::make_context(
-                first, last, success, indent, eh, n, symbol_table_tries);
-            while (success) {
+            detail::print_parser(
+                *static_cast<Context const *>(context),
+                *static_cast<Parser const *>(parser),
+                os);
+        }
+
+        // Reports the failure of parser, which was not allowed to fail, at
+        // first.
+        template<typename Context, typename Iter, typename Parser>
+        void expectation_failure_at(
+            Context const & context, Iter first, Parser const & parser)
+        {
+            if constexpr (expectation_failure_status_v<Context>) {
+                if (context.expectation_failed_) {
+                    // Only the innermost failure is reported.
+                    if (*context.expectation_failed_)
+                        return;
+                    *context.expectation_failed_ = true;
+                }
+                expectation_failure<Iter> const failure(
+                    first,
+                    std::addressof(parser),
+                    std::addressof(context),
+                    detail::print_expected_parser<Context, Parser>);
+                auto const & error_handler = *context.error_handler_;
+                error_handler_result result;
+                if constexpr (std::is_invocable_v<
+                                  decltype(error_handler),
+                                  decltype(context.first_),
+                                  decltype(context.last_),
+                                  expectation_failure<Iter> const &>) {
+                    result =
+                        error_handler(context.first_, context.last_, failure);
+                } else {
+                    result = error_handler(
+                        context.first_,
+                        context.last_,
+                        failure.to_parse_error());
+                }
+#if BOOST_PARSER_USE_EXCEPTIONS
+                if (result == error_handler_result::rethrow)
+                    throw failure.to_parse_error();
+#else
+                (void)result;
+#endif
+            } else {
+#if BOOST_PARSER_USE_EXCEPTIONS
+                std::stringstream oss;
+                detail::print_parser(context, parser, oss);
+                throw parse_error<Iter>(first, oss.str());
+#endif
+            }
+        }
+
+        // ws and blank, which are by far the most common skippers, are
+        // handled specially on contiguous char input; see skip().
+        template<typename SkipParser>
+        struct ws_skipper : std::false_type
+        {};
+        template<bool NoNewlines, typename GlobalState, typename ErrorHandler>
+        struct ws_skipper<parser_interface<
+            ws_parser<false, NoNewlines>,
+            GlobalState,
+            ErrorHandler>> : std::true_type
+        {
+            static constexpr bool no_newlines = NoNewlines;
+        };
+
+        template<typename SkipParser, typename Iter, typename Sentinel>
+        constexpr bool is_ws_skipper_v = ws_skipper<SkipParser>::value &&
+                                         is_contiguous_char_iter_v<Iter> &&
+                                         std::is_same_v<Iter, Sentinel>;
+
+        template<typename Iter, typename Sentinel, typename Context>
+        void skip(
+            Iter & first,
+            Sentinel last,
+            null_parser const & skip_,
+            flags f,
+            Context const & context)
+        {}
+
+        template<
+            typename Iter,
+            typename Sentinel,
+            typename SkipParser,
+            typename Context>
+        void skip(
+            Iter & first,
+            Sentinel last,
+            SkipParser const & skip_,
+            flags f,
+            Context const & context)
+        {
+            if (!detail::use_skip(f))
+                return;
+            if constexpr (is_ws_skipper_v<SkipParser, Iter, Sentinel>) {
+                // Skip whole runs of ASCII whitespace at once.  The parser
+                // is only used for the non-ASCII chars that it could match,
+                // which exist only if char is unsigned.
+                while (first != last) {
+                    char const * const chars_first =
+                        detail::to_char_pointer(first);
+                    char const * const chars_last =
+                        chars_first + (last - first);
+                    char const * const run_last =
+                        detail::skip_ascii_ws<
+                            ws_skipper<SkipParser>::no_newlines>(
+                            chars_first, chars_last);
+                    first += run_last - chars_first;
+                    if (first == last ||
+                        std::is_signed_v<char> || 0 <= (signed char)*first) {
+                        return;
+                    }
+                    Iter const before = first;
+                    bool success = true;
+                    skip_(
+                        std::false_type{},
+                        first,
+                        last,
+                        context,
+                        skip_skipper{},
+                        detail::disable_trace(detail::disable_skip(f)),
+                        success);
+                    if (!success || first == before)
+                        return;
+                }
+                return;
+            }
+            // The skip parser gets a context of its own, but it is made from
+            // the parts of the enclosing context that last for the whole
+            // parse, so nothing needs to be allocated or torn down for each
+            // call.
+            bool success = true;
+            rethrow_error_handler eh;
+            nope n;
+            auto skip_context = detail::make_context(
+                first,
+                last,
+                success,
+                *context.trace_indent_,
+                eh,
+                n,
+                *context.symbol_table_tries_);
+            skip_context.expectation_failed_ = context.expectation_failed_;
+            while (success) {
                 skip_(
                     std::false_type{},
                     first,
                     last,
-                    context,
+                    skip_context,
                     skip_skipper{},
                     detail::disable_trace(detail::disable_skip(f)),
                     success);
@@ -1546,14 +2292,96 @@ namespace boost { namespace parser {
         template<typename Iter, typename Sentinel, bool SortedUTF32>
         struct char_range
         {
+            constexpr char_range(BOOST_PARSER_SUBRANGE<Iter, Sentinel> chars) :
+                chars_(chars)
+            {
+                // The bitmaps are only used when every element of chars_ is
+                // a code point, one element each, and the elements outside
+                // Latin-1 fall into at most max_blocks blocks of 0x100 code
+                // points.  That means the elements must be ASCII if they
+                // are UTF-8 code units, and not surrogates if they are
+                // UTF-16 code units.
+                using element_type = remove_cv_ref_t<decltype(*chars_.begin())>;
+
+                // The case foldings of the elements, as they are searched
+                // under no_case.
+                latin1_bitmap folded;
+                bool folded_mu = false;
+                bool folded_ss = false;
+                bool latin1_only = true;
+                char32_t prev_folded = 0;
+                for (auto it = chars_.begin(); it != chars_.end(); ++it) {
+                    uint32_t const c = std::make_unsigned_t<element_type>(*it);
+                    bool const code_point = sizeof(element_type) == 1 ? c < 0x80
+                                            : sizeof(element_type) == 2
+                                                ? c < 0xd800 || 0xe000 <= c
+                                                : c < 0x110000;
+                    if (!code_point)
+                        return;
+                    if (0x100 <= c) {
+                        if (!add_to_block(c))
+                            return;
+                        latin1_only = false;
+                        continue;
+                    }
+                    bitmap_.add(c);
+                    char32_t const f = c == 0xdf ? U's' : latin1_case_fold(c);
+                    if (f == 0x03bc)
+                        folded_mu = true;
+                    else
+                        folded.add(f);
+                    if (c == 0xdf || (f == U's' && prev_folded == U's'))
+                        folded_ss = true;
+                    prev_folded = f;
+                }
+                use_bitmaps_ = true;
+
+                // Elements outside Latin-1 can match Latin-1 chars under
+                // no_case (U+212A KELVIN SIGN matches 'k'), so the no_case
+                // bitmap is only used for sets of Latin-1 elements.
+                if (!latin1_only)
+                    return;
+                for (uint32_t c = 0; c < 0x100; ++c) {
+                    char32_t const f = c == 0xdf ? 0 : latin1_case_fold(c);
+                    if (c == 0xdf ? folded_ss
+                                  : f == 0x03bc ? folded_mu
+                                                : folded.contains(f)) {
+                        no_case_bitmap_.add(c);
+                    }
+                }
+                use_no_case_bitmap_ = true;
+            }
+
             template<typename T, typename Context>
             bool contains(T c_, Context const & context) const
             {
+                if constexpr (SortedUTF32 || !Context::no_case) {
+                    if (use_bitmaps_) {
+                        uint32_t const c = c_;
+                        if (c < 0x100)
+                            return bitmap_.contains(c);
+                        for (int i = 0; i < blocks_size_; ++i) {
+                            if (block_ids_[i] == c >> 8)
+                                return blocks_[i].contains(c & 0xff);
+                        }
+                        return false;
+                    }
+                } else {
+                    if (use_no_case_bitmap_) {
+                        uint32_t const c = c_;
+                        if (c < 0x100)
+                            return no_case_bitmap_.contains(c);
+                        // Outside Latin-1, only case insensitive matches
+                        // are possible, as in U+212A KELVIN SIGN matching
+                        // 'k'.
+                    }
+                }
+
                 if constexpr (SortedUTF32) {
                     return std::binary_search(chars_.begin(), chars_.end(), c_);
                 }
 
-                if (context.no_case_depth_) {
+                if constexpr (Context::no_case) {
                     case_fold_array_t folded;
                     auto folded_last = detail::case_fold(c_, folded.begin());
                     if constexpr (std::is_same_v<T, char32_t>) {
@@ -1591,7 +2419,39 @@ namespace boost { namespace parser {
                 }
             }
 
+            // Adds c, which is outside Latin-1, to the bitmap of its block,
+            // if there is room for the block.
+            constexpr bool add_to_block(uint32_t c)
+            {
+                int i = 0;
+                while (i < blocks_size_ && block_ids_[i] != c >> 8) {
+                    ++i;
+                }
+                if (i == blocks_size_) {
+                    if (i == max_blocks)
+                        return false;
+                    block_ids_[i] = c >> 8;
+                    ++blocks_size_;
+                }
+                blocks_[i].add(c & 0xff);
+                return true;
+            }
+
+            static constexpr int max_blocks = 4;
+
             BOOST_PARSER_SUBRANGE<Iter, Sentinel> chars_;
+            // The elements of chars_, and the chars that match one of them
+            // under no_case, among the first 0x100 code points.
+            latin1_bitmap bitmap_;
+            latin1_bitmap no_case_bitmap_;
+            // The elements of chars_ outside Latin-1, in a bitmap for each
+            // block of 0x100 code points that has any, with the blocks'
+            // indices (code point >> 8) in block_ids_.
+            uint32_t block_ids_[max_blocks] = {};
+            latin1_bitmap blocks_[max_blocks];
+            int blocks_size_ = 0;
+            bool use_bitmaps_ = false;
+            bool use_no_case_bitmap_ = false;
         };
 
         template<bool SortedUTF32, typename Iter, typename Sentinel>
@@ -1615,8 +2475,8 @@ namespace boost { namespace parser {
         template<bool Equal, typename Context>
         auto no_case_aware_compare(Context const & context)
         {
-            return [no_case = context.no_case_depth_](char32_t a, char32_t b) {
-                if (no_case) {
+            return [](char32_t a, char32_t b) {
+                if constexpr (Context::no_case) {
                     case_fold_array_t folded_a = {0, 0, 0};
                     detail::case_fold(a, folded_a.begin());
                     case_fold_array_t folded_b = {0, 0, 0};
@@ -1679,6 +2539,20 @@ namespace boost { namespace parser {
                 context, c, expected);
         }
 
+        template<
+            typename Context,
+            typename CharType,
+            typename Iter,
+            typename Sentinel,
+            bool SortedUTF32>
+        bool unequal(
+            Context const & context,
+            CharType c,
+            char_range<Iter, Sentinel, SortedUTF32> const & expected)
+        {
+            return !expected.contains(c, context);
+        }
+
         template<
             typename Context,
             typename CharType,
@@ -1742,6 +2616,110 @@ namespace boost { namespace parser {
         constexpr bool is_constructible_from_tuple_v<T, Tuple, true> =
             is_detected_v<constructible_from_tuple_expr, T, Tuple>;
 
+        template<typename T>
+        struct using_allocator_maker
+        {
+            template<typename Alloc>
+            static T call(Alloc const & alloc)
+            {
+                if constexpr (std::is_constructible_v<T, Alloc const &>)
+                    return T(alloc);
+                else
+                    return T();
+            }
+        };
+
+        template<typename... T>
+        struct using_allocator_maker<tuple<T...>>
+        {
+            template<typename Alloc>
+            static tuple<T...> call(Alloc const & alloc)
+            {
+                return tuple<T...>(using_allocator_maker<T>::call(alloc)...);
+            }
+        };
+
+        // Returns a T that allocates with alloc, if T is allocator-aware, or
+        // a tuple of such Ts.  Otherwise, returns T().
+        template<typename T, typename Alloc>
+        T make_using_allocator(Alloc const & alloc)
+        {
+            return using_allocator_maker<T>::call(alloc);
+        }
+
+        // A pointer to a memory resource is passed to parse() to say where
+        // the attribute should allocate from; it is never the attribute.
+#if defined(__cpp_lib_memory_resource)
+        template<typename T>
+        constexpr bool is_memory_resource_pointer_v =
+            std::is_pointer_v<std::remove_cv_t<T>> &&
+            std::is_base_of_v<
+                std::pmr::memory_resource,
+                std::remove_cv_t<std::remove_pointer_t<std::remove_cv_t<T>>>>;
+#else
+        template<typename T>
+        constexpr bool is_memory_resource_pointer_v = false;
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+        template<typename T>
+        struct pmr_attribute
+        {
+            using type = T;
+        };
+        template<typename T>
+        using pmr_attribute_t = typename pmr_attribute<T>::type;
+
+        template<typename Char, typename Traits>
+        struct pmr_attribute<std::basic_string<Char, Traits>>
+        {
+            using type = std::pmr::basic_string<Char, Traits>;
+        };
+        template<typename T>
+        struct pmr_attribute<std::vector<T>>
+        {
+            using type = std::pmr::vector<pmr_attribute_t<T>>;
+        };
+        template<typename T>
+        struct pmr_attribute<std::optional<T>>
+        {
+            using type = std::optional<pmr_attribute_t<T>>;
+        };
+        template<typename... T>
+        struct pmr_attribute<std::variant<T...>>
+        {
+            using type = std::variant<pmr_attribute_t<T>...>;
+        };
+        template<typename... T>
+        struct pmr_attribute<tuple<T...>>
+        {
+            using type = tuple<pmr_attribute_t<T>...>;
+        };
+#endif
+
+        template<typename T>
+        using get_allocator_expr =
+            decltype(std::declval<T const &>().get_allocator());
+
+        // Returns a T to be parsed into and then moved into x.  If x uses a
+        // stateful allocator (like std::pmr::polymorphic_allocator), the T
+        // uses x's allocator too, so that moving it into x does not copy it.
+        template<typename T, typename U>
+        T make_using_allocator_of(U const & x)
+        {
+            if constexpr (is_detected_v<get_allocator_expr, U>) {
+                using alloc_t = detected_t<get_allocator_expr, U>;
+                if constexpr (!std::allocator_traits<
+                                  alloc_t>::is_always_equal::value) {
+                    return detail::make_using_allocator<T>(x.get_allocator());
+                } else {
+                    return T();
+                }
+            } else {
+                return T();
+            }
+        }
+
         template<typename Container, typename U>
         constexpr void move_back_impl(Container & c, U && x)
         {
@@ -1780,6 +2758,12 @@ namespace boost { namespace parser {
                                      just_u>) {
                 detail::insert(
                     c, detail::make_from_tuple<just_t>(std::move(x)));
+            } else if constexpr (
+                container<just_t> && container<just_u> &&
+                std::is_same_v<range_value_t<just_t>, range_value_t<just_u>>) {
+                // For instance, a std::string inserted into a container of
+                // std::pmr::string.
+                detail::insert(c, just_t(x.begin(), x.end()));
             } else {
                 static_assert(
                     sizeof(U) && false,
@@ -2066,6 +3050,46 @@ namespace boost { namespace parser {
             Iter & it_;
         };
 
+        // Returns the result of parse(), or of fail() if parse() throws a
+        // parse_error that error_handler does not ask to have rethrown.  An
+        // expectation failure that was already passed to error_handler (see
+        // expectation_failure_at()) is only thrown if error_handler asked for
+        // that, so it is not passed to error_handler again.
+        template<
+            typename Iter,
+            typename Sentinel,
+            typename ErrorHandler,
+            typename Parse,
+            typename Fail>
+        auto handle_parse_errors(
+            Iter initial_first,
+            Sentinel last,
+            ErrorHandler const & error_handler,
+            bool const & expectation_failed,
+            Parse const & parse,
+            Fail const & fail)
+        {
+#if BOOST_PARSER_USE_EXCEPTIONS
+            try {
+                return parse();
+            } catch (parse_error<Iter> const & e) {
+                if (expectation_failed ||
+                    error_handler(initial_first, last, e) ==
+                        error_handler_result::rethrow) {
+                    throw;
+                }
+                return fail();
+            }
+#else
+            (void)initial_first;
+            (void)last;
+            (void)error_handler;
+            (void)expectation_failed;
+            (void)fail;
+            return parse();
+#endif
+        }
+
         template<
             bool Debug,
             typename Iter,
@@ -2082,9 +3106,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2092,29 +3117,30 @@ namespace boost { namespace parser {
                 error_handler,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::flags::gen_attrs)
                       : detail::flags::gen_attrs;
-            try {
-                parser(
-                    std::false_type{},
-                    first,
-                    last,
-                    context,
-                    detail::null_parser{},
-                    flags,
-                    success,
-                    attr);
-                if (Debug)
-                    detail::final_trace(context, flags, attr);
-                return success;
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                return false;
-            }
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    parser(
+                        std::false_type{},
+                        first,
+                        last,
+                        context,
+                        detail::null_parser{},
+                        flags,
+                        success,
+                        attr);
+                    if (Debug)
+                        detail::final_trace(context, flags, attr);
+                    return success && !expectation_failed;
+                },
+                [] { return false; });
         }
 
         template<
@@ -2131,9 +3157,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2141,6 +3168,7 @@ namespace boost { namespace parser {
                 error_handler,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::flags::gen_attrs)
                       : detail::flags::gen_attrs;
@@ -2152,26 +3180,29 @@ namespace boost { namespace parser {
                 detail::null_parser{},
                 flags,
                 success));
-            try {
-                attr_t attr_ = parser(
-                    std::false_type{},
-                    first,
-                    last,
-                    context,
-                    detail::null_parser{},
-                    flags,
-                    success);
-                if (Debug)
-                    detail::final_trace(context, flags, nope{});
-                return detail::make_parse_result(attr_, success);
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                attr_t attr_{};
-                return detail::make_parse_result(attr_, false);
-            }
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    attr_t attr_ = parser(
+                        std::false_type{},
+                        first,
+                        last,
+                        context,
+                        detail::null_parser{},
+                        flags,
+                        success);
+                    if (Debug)
+                        detail::final_trace(context, flags, nope{});
+                    return detail::make_parse_result(
+                        attr_, success && !expectation_failed);
+                },
+                [] {
+                    attr_t attr_{};
+                    return detail::make_parse_result(attr_, false);
+                });
         }
 
         template<
@@ -2190,9 +3221,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2201,28 +3233,29 @@ namespace boost { namespace parser {
                 callbacks,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::flags::gen_attrs)
                       : detail::flags::gen_attrs;
-            try {
-                parser(
-                    std::true_type{},
-                    first,
-                    last,
-                    context,
-                    detail::null_parser{},
-                    flags,
-                    success);
-                if (Debug)
-                    detail::final_trace(context, flags, nope{});
-                return success;
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                return false;
-            }
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    parser(
+                        std::true_type{},
+                        first,
+                        last,
+                        context,
+                        detail::null_parser{},
+                        flags,
+                        success);
+                    if (Debug)
+                        detail::final_trace(context, flags, nope{});
+                    return success && !expectation_failed;
+                },
+                [] { return false; });
         }
 
         template<
@@ -2243,9 +3276,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2253,31 +3287,32 @@ namespace boost { namespace parser {
                 error_handler,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::default_flags())
                       : detail::default_flags();
-            detail::skip(first, last, skip, flags);
-            try {
-                parser(
-                    std::false_type{},
-                    first,
-                    last,
-                    context,
-                    skip,
-                    flags,
-                    success,
-                    attr);
-                detail::skip(first, last, skip, flags);
-                if (Debug)
-                    detail::final_trace(context, flags, attr);
-                return success;
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                return false;
-            }
+            detail::skip(first, last, skip, flags, context);
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    parser(
+                        std::false_type{},
+                        first,
+                        last,
+                        context,
+                        skip,
+                        flags,
+                        success,
+                        attr);
+                    detail::skip(first, last, skip, flags, context);
+                    if (Debug)
+                        detail::final_trace(context, flags, attr);
+                    return success && !expectation_failed;
+                },
+                [] { return false; });
         }
 
         template<
@@ -2296,9 +3331,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2306,33 +3342,37 @@ namespace boost { namespace parser {
                 error_handler,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::default_flags())
                       : detail::default_flags();
-            detail::skip(first, last, skip, flags);
+            detail::skip(first, last, skip, flags, context);
             using attr_t = decltype(parser(
                 std::false_type{}, first, last, context, skip, flags, success));
-            try {
-                attr_t attr_ = parser(
-                    std::false_type{},
-                    first,
-                    last,
-                    context,
-                    skip,
-                    flags,
-                    success);
-                detail::skip(first, last, skip, flags);
-                if (Debug)
-                    detail::final_trace(context, flags, nope{});
-                return detail::make_parse_result(attr_, success);
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                attr_t attr_{};
-                return detail::make_parse_result(attr_, false);
-            }
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    attr_t attr_ = parser(
+                        std::false_type{},
+                        first,
+                        last,
+                        context,
+                        skip,
+                        flags,
+                        success);
+                    detail::skip(first, last, skip, flags, context);
+                    if (Debug)
+                        detail::final_trace(context, flags, nope{});
+                    return detail::make_parse_result(
+                        attr_, success && !expectation_failed);
+                },
+                [] {
+                    attr_t attr_{};
+                    return detail::make_parse_result(attr_, false);
+                });
         }
 
         template<
@@ -2353,9 +3393,10 @@ namespace boost { namespace parser {
         {
             auto const initial_first = first;
             bool success = true;
+            bool expectation_failed = false;
             int trace_indent = 0;
             detail::symbol_table_tries_t symbol_table_tries;
-            auto context = detail::make_context(
+            auto context = detail::make_context<Debug>(
                 first,
                 last,
                 success,
@@ -2364,30 +3405,31 @@ namespace boost { namespace parser {
                 callbacks,
                 parser.globals_,
                 symbol_table_tries);
+            context.expectation_failed_ = &expectation_failed;
             auto const flags =
                 Debug ? detail::enable_trace(detail::default_flags())
                       : detail::default_flags();
-            detail::skip(first, last, skip, flags);
-            try {
-                parser(
-                    std::true_type{},
-                    first,
-                    last,
-                    context,
-                    skip,
-                    flags,
-                    success);
-                detail::skip(first, last, skip, flags);
-                if (Debug)
-                    detail::final_trace(context, flags, nope{});
-                return success;
-            } catch (parse_error<Iter> const & e) {
-                if (error_handler(initial_first, last, e) ==
-                    error_handler_result::rethrow) {
-                    throw;
-                }
-                return false;
-            }
+            detail::skip(first, last, skip, flags, context);
+            return detail::handle_parse_errors(
+                initial_first,
+                last,
+                error_handler,
+                expectation_failed,
+                [&] {
+                    parser(
+                        std::true_type{},
+                        first,
+                        last,
+                        context,
+                        skip,
+                        flags,
+                        success);
+                    detail::skip(first, last, skip, flags, context);
+                    if (Debug)
+                        detail::final_trace(context, flags, nope{});
+                    return success && !expectation_failed;
+                },
+                [] { return false; });
         }
 
         template<typename R>
@@ -2415,8 +3457,9 @@ namespace boost { namespace parser {
                     }
                 } else {
                     if constexpr (
-                        std::is_same_v<value_type, char> &&
-                        !is_utf8_view<r_t>::value) {
+                        (std::is_same_v<value_type, char> &&
+                         !is_utf8_view<r_t>::value) ||
+                        is_decoded_utf32_v<r_t>) {
                         return BOOST_PARSER_SUBRANGE(
                             detail::text::detail::begin(r),
                             detail::text::detail::end(r));
@@ -2470,18 +3513,15 @@ namespace boost { namespace parser {
         }
 
         template<
+            bool NoCase,
             typename Iter1,
             typename Sentinel1,
             typename Iter2,
             typename Sentinel2>
         std::pair<Iter1, Iter2> no_case_aware_string_mismatch(
-            Iter1 first1,
-            Sentinel1 last1,
-            Iter2 first2,
-            Sentinel2 last2,
-            bool no_case)
+            Iter1 first1, Sentinel1 last1, Iter2 first2, Sentinel2 last2)
         {
-            if (no_case) {
+            if constexpr (NoCase) {
                 auto it1 = no_case_iter(first1, last1);
                 auto it2 = no_case_iter(first2, last2);
                 auto const mismatch = detail::mismatch(
@@ -2703,7 +3743,7 @@ namespace boost { namespace parser {
     template<typename Context>
     decltype(auto) _no_case(Context const & context)
     {
-        return context.no_case_depth_;
+        return Context::no_case;
     }
 
     template<typename Context>
@@ -2797,9 +3837,23 @@ namespace boost { namespace parser {
         {
             using attr_t = decltype(parser_.call(
                 use_cbs, first, last, context, skip, flags, success));
-            auto retval = detail::make_sequence_of<attr_t>();
-            call(use_cbs, first, last, context, skip, flags, success, retval);
-            return retval;
+            if constexpr (detail::yields_string_view_v<
+                              Context,
+                              Iter,
+                              SkipParser,
+                              Parser,
+                              attr_t,
+                              DelimiterParser>) {
+                std::string_view retval;
+                call(
+                    use_cbs, first, last, context, skip, flags, success, retval);
+                return retval;
+            } else {
+                auto retval = detail::make_sequence_of<attr_t>();
+                call(
+                    use_cbs, first, last, context, skip, flags, success, retval);
+                return retval;
+            }
         }
 
         template<
@@ -2828,7 +3882,34 @@ namespace boost { namespace parser {
                                                : flags,
                 retval);
 
-            if constexpr (detail::is_optional_v<Attribute>) {
+            using parser_attr_t = decltype(parser_.call(
+                use_cbs, first, last, context, skip, flags, success));
+            if constexpr (
+                detail::yields_string_view_v<
+                    Context,
+                    Iter,
+                    SkipParser,
+                    Parser,
+                    parser_attr_t,
+                    DelimiterParser> &&
+                std::is_same_v<Attribute, std::string_view>) {
+                auto const initial_first = first;
+                // Since attributes are disabled, this stays empty.
+                auto attr = detail::make_sequence_of<parser_attr_t>();
+                call(
+                    use_cbs,
+                    first,
+                    last,
+                    context,
+                    skip,
+                    detail::disable_attrs(flags),
+                    success,
+                    attr);
+                if (!success)
+                    retval = std::string_view();
+                else if (detail::gen_attrs(flags))
+                    retval = detail::to_string_view(initial_first, first);
+            } else if constexpr (detail::is_optional_v<Attribute>) {
                 detail::optional_type<Attribute> attr;
                 detail::apply_parser(
                     *this,
@@ -2852,8 +3933,8 @@ namespace boost { namespace parser {
 
                 for (int64_t end = detail::resolve(context, min_); count != end;
                      ++count) {
-                    detail::skip(first, last, skip, flags);
-                    attr_t attr;
+                    detail::skip(first, last, skip, flags, context);
+                    attr_t attr = detail::make_using_allocator_of<attr_t>(retval);
                     parser_.call(
                         use_cbs,
                         first,
@@ -2884,7 +3965,7 @@ namespace boost { namespace parser {
                     // always has a min=1; we therefore know we're after a
                     // previous element when this executes.
                     if constexpr (!detail::is_nope_v<DelimiterParser>) {
-                        detail::skip(first, last, skip, flags);
+                        detail::skip(first, last, skip, flags, context);
                         delimiter_parser_.call(
                             use_cbs,
                             first,
@@ -2894,14 +3975,16 @@ namespace boost { namespace parser {
                             detail::disable_attrs(flags),
                             success);
                         if (!success) {
+                            if (detail::expectation_failed(context))
+                                return;
                             success = true;
                             first = prev_first;
                             break;
                         }
                     }
 
-                    detail::skip(first, last, skip, flags);
-                    attr_t attr;
+                    detail::skip(first, last, skip, flags, context);
+                    attr_t attr = detail::make_using_allocator_of<attr_t>(retval);
                     parser_.call(
                         use_cbs,
                         first,
@@ -2912,6 +3995,8 @@ namespace boost { namespace parser {
                         success,
                         attr);
                     if (!success) {
+                        if (detail::expectation_failed(context))
+                            return;
                         success = true;
                         first = prev_first;
                         break;
@@ -3014,35 +4099,501 @@ namespace boost { namespace parser {
             //]
 
             //[ opt_parser_skip
-            detail::skip(first, last, skip, flags);
+            detail::skip(first, last, skip, flags, context);
             //]
 
             //[ opt_parser_no_gen_attr_path
             if (!detail::gen_attrs(flags)) {
                 parser_.call(
                     use_cbs, first, last, context, skip, flags, success);
-                success = true;
+                if (!detail::expectation_failed(context))
+                    success = true;
                 return;
             }
-            //]
-
-            //[ opt_parser_gen_attr_path
-            parser_.call(
-                use_cbs, first, last, context, skip, flags, success, retval);
-            success = true;
-            //]
+            //]
+
+            //[ opt_parser_gen_attr_path
+            parser_.call(
+                use_cbs, first, last, context, skip, flags, success, retval);
+            if (!detail::expectation_failed(context))
+                success = true;
+            //]
+        }
+        //]
+
+        //[ opt_parser_end
+        Parser parser_;
+    };
+    //]
+
+    namespace detail {
+        // The ASCII chars that can begin a match of a parser, once any
+        // skipping has been done.  or_parser uses these to find out which of
+        // its alternatives can match, from the next char alone.
+        struct ascii_first_set
+        {
+            constexpr void add(uint32_t c)
+            {
+                if (c < 128)
+                    bits_[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+            constexpr void add(uint32_t lo, uint32_t hi)
+            {
+                for (; lo <= hi && lo < 128; ++lo) {
+                    add(lo);
+                }
+            }
+            constexpr bool contains(uint32_t c) const
+            {
+                return (bits_[c >> 6] >> (c & 63)) & 1;
+            }
+
+            uint64_t bits_[2] = {};
+        };
+
+        // The first set of a parser is only known for the parsers this is
+        // specialized for; those specializations are std::true_type.  Even
+        // for those, call() returns false when the first set depends on
+        // something only known during the parse (a lazy value, say), or
+        // when the parser can match without consuming anything.  Case
+        // insensitivity is not taken into account; or_parser does not use
+        // first sets inside no_case[].
+        template<typename Parser>
+        struct first_set_maker : std::false_type
+        {
+            static constexpr bool call(Parser const &, ascii_first_set &)
+            {
+                return false;
+            }
+        };
+
+        template<typename Parser>
+        constexpr bool make_first_set(Parser const & parser, ascii_first_set & set)
+        {
+            return first_set_maker<Parser>::call(parser, set);
+        }
+
+        template<typename Expected, typename AttributeType>
+        struct first_set_maker<char_parser<Expected, AttributeType>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                char_parser<Expected, AttributeType> const & parser,
+                ascii_first_set & set)
+            {
+                if constexpr (is_parsable_code_unit_v<Expected>) {
+                    set.add(char32_t(parser.expected_));
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        };
+
+        template<typename LoType, typename HiType, typename AttributeType>
+        struct first_set_maker<
+            char_parser<char_pair<LoType, HiType>, AttributeType>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                char_parser<char_pair<LoType, HiType>, AttributeType> const &
+                    parser,
+                ascii_first_set & set)
+            {
+                if constexpr (
+                    is_parsable_code_unit_v<LoType> &&
+                    is_parsable_code_unit_v<HiType>) {
+                    set.add(
+                        char32_t(parser.expected_.lo_),
+                        char32_t(parser.expected_.hi_));
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        };
+
+        template<
+            typename Iter,
+            typename Sentinel,
+            bool SortedUTF32,
+            typename AttributeType>
+        struct first_set_maker<char_parser<
+            char_range<Iter, Sentinel, SortedUTF32>,
+            AttributeType>> : std::true_type
+        {
+            static constexpr bool call(
+                char_parser<
+                    char_range<Iter, Sentinel, SortedUTF32>,
+                    AttributeType> const & parser,
+                ascii_first_set & set)
+            {
+                // Only ASCII chars are added, and those are the same code
+                // units in every encoding.
+                for (auto it = parser.expected_.chars_.begin();
+                     it != parser.expected_.chars_.end();
+                     ++it) {
+                    using char_t = remove_cv_ref_t<decltype(*it)>;
+                    set.add(uint32_t(std::make_unsigned_t<char_t>(*it)));
+                }
+                return true;
+            }
+        };
+
+        template<typename Tag>
+        struct first_set_maker<char_set_parser<Tag>> : std::true_type
+        {
+            static constexpr bool
+            call(char_set_parser<Tag> const &, ascii_first_set & set)
+            {
+                for (uint32_t c : detail::char_set<Tag>::chars) {
+                    set.add(c);
+                }
+                return true;
+            }
+        };
+
+        template<typename Tag>
+        struct first_set_maker<char_subrange_parser<Tag>> : std::true_type
+        {
+            static constexpr bool
+            call(char_subrange_parser<Tag> const &, ascii_first_set & set)
+            {
+                for (auto subrange : detail::char_subranges<Tag>::ranges) {
+                    set.add(subrange.lo_, subrange.hi_);
+                }
+                return true;
+            }
+        };
+
+        template<>
+        struct first_set_maker<digit_parser> : std::true_type
+        {
+            static constexpr bool
+            call(digit_parser const &, ascii_first_set & set)
+            {
+                set.add('0', '9');
+                return true;
+            }
+        };
+
+        template<bool NewlinesOnly, bool NoNewlines>
+        struct first_set_maker<ws_parser<NewlinesOnly, NoNewlines>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                ws_parser<NewlinesOnly, NoNewlines> const &,
+                ascii_first_set & set)
+            {
+                if constexpr (NewlinesOnly) {
+                    set.add('\n', '\r');
+                } else if constexpr (NoNewlines) {
+                    set.add('\t');
+                    set.add(' ');
+                } else {
+                    set.add('\t', '\r');
+                    set.add(' ');
+                }
+                return true;
+            }
+        };
+
+        template<typename StrIter, typename StrSentinel>
+        struct first_set_maker<string_parser<StrIter, StrSentinel>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                string_parser<StrIter, StrSentinel> const & parser,
+                ascii_first_set & set)
+            {
+                if (parser.expected_first_ == parser.expected_last_)
+                    return false;
+                using char_t = remove_cv_ref_t<decltype(*parser.expected_first_)>;
+                set.add(uint32_t(std::make_unsigned_t<char_t>(
+                    *parser.expected_first_)));
+                return true;
+            }
+        };
+
+        template<>
+        struct first_set_maker<bool_parser> : std::true_type
+        {
+            static constexpr bool
+            call(bool_parser const &, ascii_first_set & set)
+            {
+                set.add('f');
+                set.add('t');
+                return true;
+            }
+        };
+
+        template<int Radix>
+        constexpr void add_digits(ascii_first_set & set)
+        {
+            set.add('0', '0' + (std::min)(Radix, 10) - 1);
+            if constexpr (10 < Radix) {
+                set.add('a', 'a' + Radix - 11);
+                set.add('A', 'A' + Radix - 11);
+            }
+        }
+
+        template<
+            typename T,
+            int Radix,
+            int MinDigits,
+            int MaxDigits,
+            typename Expected>
+        struct first_set_maker<
+            uint_parser<T, Radix, MinDigits, MaxDigits, Expected>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                uint_parser<T, Radix, MinDigits, MaxDigits, Expected> const &,
+                ascii_first_set & set)
+            {
+                detail::add_digits<Radix>(set);
+                set.add('+');
+                return true;
+            }
+        };
+
+        template<
+            typename T,
+            int Radix,
+            int MinDigits,
+            int MaxDigits,
+            typename Expected>
+        struct first_set_maker<
+            int_parser<T, Radix, MinDigits, MaxDigits, Expected>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                int_parser<T, Radix, MinDigits, MaxDigits, Expected> const &,
+                ascii_first_set & set)
+            {
+                detail::add_digits<Radix>(set);
+                set.add('+');
+                set.add('-');
+                return true;
+            }
+        };
+
+        template<typename T, bool CorrectlyRounded>
+        struct first_set_maker<float_parser<T, CorrectlyRounded>>
+            : std::true_type
+        {
+            static constexpr bool call(
+                float_parser<T, CorrectlyRounded> const &,
+                ascii_first_set & set)
+            {
+                // Digits, a sign, a leading '.', "inf" and "nan".
+                detail::add_digits<10>(set);
+                set.add('+');
+                set.add('-');
+                set.add('.');
+                set.add('i');
+                set.add('I');
+                set.add('n');
+                set.add('N');
+                return true;
+            }
+        };
+
+        template<typename T>
+        struct first_set_maker<json_number_parser<T>> : std::true_type
+        {
+            static constexpr bool
+            call(json_number_parser<T> const &, ascii_first_set & set)
+            {
+                detail::add_digits<10>(set);
+                set.add('-');
+                return true;
+            }
+        };
+
+        template<typename Parser>
+        struct first_set_maker<omit_parser<Parser>> : first_set_maker<Parser>
+        {
+            static constexpr bool
+            call(omit_parser<Parser> const & parser, ascii_first_set & set)
+            {
+                return detail::make_first_set(parser.parser_, set);
+            }
+        };
+
+        template<typename Parser>
+        struct first_set_maker<raw_parser<Parser>> : first_set_maker<Parser>
+        {
+            static constexpr bool
+            call(raw_parser<Parser> const & parser, ascii_first_set & set)
+            {
+                return detail::make_first_set(parser.parser_, set);
+            }
+        };
+
+#if defined(__cpp_lib_concepts)
+        template<typename Parser>
+        struct first_set_maker<string_view_parser<Parser>>
+            : first_set_maker<Parser>
+        {
+            static constexpr bool call(
+                string_view_parser<Parser> const & parser,
+                ascii_first_set & set)
+            {
+                return detail::make_first_set(parser.parser_, set);
+            }
+        };
+#endif
+
+        template<typename Parser>
+        struct first_set_maker<views_parser<Parser>> : first_set_maker<Parser>
+        {
+            static constexpr bool
+            call(views_parser<Parser> const & parser, ascii_first_set & set)
+            {
+                return detail::make_first_set(parser.parser_, set);
+            }
+        };
+
+        template<typename Parser, typename Action>
+        struct first_set_maker<action_parser<Parser, Action>>
+            : first_set_maker<Parser>
+        {
+            static constexpr bool call(
+                action_parser<Parser, Action> const & parser,
+                ascii_first_set & set)
+            {
+                return detail::make_first_set(parser.parser_, set);
+            }
+        };
+
+        template<
+            typename Parser,
+            typename DelimiterParser,
+            typename MinType,
+            typename MaxType>
+        struct first_set_maker<
+            repeat_parser<Parser, DelimiterParser, MinType, MaxType>>
+            : std::bool_constant<
+                  first_set_maker<Parser>::value &&
+                  std::is_integral_v<MinType>>
+        {
+            static constexpr bool call(
+                repeat_parser<Parser, DelimiterParser, MinType, MaxType> const &
+                    parser,
+                ascii_first_set & set)
+            {
+                if constexpr (std::is_integral_v<MinType>) {
+                    if (1 <= parser.min_)
+                        return detail::make_first_set(parser.parser_, set);
+                }
+                return false;
+            }
+        };
+
+        template<typename Parser>
+        struct first_set_maker<one_plus_parser<Parser>>
+            : first_set_maker<repeat_parser<Parser>>
+        {};
+
+        template<typename Parser, typename DelimiterParser>
+        struct first_set_maker<delimited_seq_parser<Parser, DelimiterParser>>
+            : first_set_maker<repeat_parser<Parser, DelimiterParser>>
+        {};
+
+        template<
+            typename ParserTuple,
+            typename BacktrackingTuple,
+            typename CombiningGroups>
+        struct first_set_maker<
+            seq_parser<ParserTuple, BacktrackingTuple, CombiningGroups>>
+            : first_set_maker<remove_cv_ref_t<
+                  decltype(parser::get(std::declval<ParserTuple>(), llong<0>{}))>>
+        {
+            static constexpr bool call(
+                seq_parser<ParserTuple, BacktrackingTuple, CombiningGroups> const &
+                    parser,
+                ascii_first_set & set)
+            {
+                return detail::make_first_set(
+                    parser::get(parser.parsers_, llong<0>{}), set);
+            }
+        };
+
+        template<typename ParserTuple>
+        struct first_set_maker<or_parser<ParserTuple>> : std::true_type
+        {
+            static constexpr bool
+            call(or_parser<ParserTuple> const & parser, ascii_first_set & set)
+            {
+                bool retval = true;
+                detail::hl::for_each(parser.parsers_, [&](auto const & p) {
+                    retval = detail::make_first_set(p, set) && retval;
+                });
+                return retval;
+            }
+        };
+
+        // For each ASCII char, the alternatives of an or_parser that can
+        // match when the next char is that char, as a bitmask in which bit
+        // i is set for the i-th alternative.
+        template<std::size_t N>
+        struct or_dispatch_table
+        {
+            static_assert(N <= 64);
+            using mask_type = std::conditional_t<
+                N <= 8,
+                uint8_t,
+                std::conditional_t<
+                    N <= 16,
+                    uint16_t,
+                    std::conditional_t<N <= 32, uint32_t, uint64_t>>>;
+
+            mask_type viable_[128] = {};
+        };
+
+        template<typename... Parsers>
+        constexpr bool use_or_dispatch_table_v =
+            2 <= sizeof...(Parsers) && sizeof...(Parsers) <= 64 &&
+            (first_set_maker<Parsers>::value && ...);
+
+        template<typename... Parsers>
+        constexpr auto make_or_dispatch_table(tuple<Parsers...> const & parsers)
+        {
+            if constexpr (use_or_dispatch_table_v<Parsers...>) {
+                constexpr std::size_t n = sizeof...(Parsers);
+                using table_type = or_dispatch_table<n>;
+                using mask_type = typename table_type::mask_type;
+                ascii_first_set sets[n] = {};
+                bool known[n] = {};
+                std::size_t i = 0;
+                detail::hl::for_each(parsers, [&](auto const & p) {
+                    known[i] = detail::make_first_set(p, sets[i]);
+                    ++i;
+                });
+                table_type retval;
+                for (uint32_t c = 0; c < 128; ++c) {
+                    mask_type viable = 0;
+                    for (std::size_t j = 0; j < n; ++j) {
+                        if (!known[j] || sets[j].contains(c))
+                            viable |= mask_type(1) << j;
+                    }
+                    retval.viable_[c] = viable;
+                }
+                return retval;
+            } else {
+                return nope{};
+            }
         }
-        //]
-
-        //[ opt_parser_end
-        Parser parser_;
-    };
-    //]
+    }
 
     template<typename ParserTuple>
     struct or_parser
     {
-        constexpr or_parser(ParserTuple parsers) : parsers_(parsers) {}
+        constexpr or_parser(ParserTuple parsers) :
+            parsers_(parsers),
+            dispatch_table_(detail::make_or_dispatch_table(parsers_))
+        {}
 
 #ifndef BOOST_PARSER_DOXYGEN
 
@@ -3057,7 +4608,7 @@ namespace boost { namespace parser {
             template<typename Parser>
             auto operator()(Parser const & parser) const
             {
-                detail::skip(first_, last_, skip_, flags_);
+                detail::skip(first_, last_, skip_, flags_, context_);
                 success_ = true; // In case someone earlier already failed...
                 return parser.call(
                     std::bool_constant<UseCallbacks>{},
@@ -3072,7 +4623,7 @@ namespace boost { namespace parser {
             template<typename Parser, typename Attribute>
             void operator()(Parser const & parser, Attribute & retval) const
             {
-                detail::skip(first_, last_, skip_, flags_);
+                detail::skip(first_, last_, skip_, flags_, context_);
                 success_ = true; // In case someone earlier already failed...
 
                 detail::apply_parser(
@@ -3196,6 +4747,12 @@ namespace boost { namespace parser {
                 SkipParser> const use_parser{
                 first, last, context, skip, flags, success};
 
+            // use_parser skips before each alternative, so skipping once
+            // here gives the same result, and alternatives that fail do not
+            // cause the same input to be skipped again.
+            Iter const initial_first = first;
+            detail::skip(first, last, skip, flags, context);
+
             bool done = false;
             auto try_parser = [prev_first = first,
                                use_parser,
@@ -3205,6 +4762,11 @@ namespace boost { namespace parser {
                                &done](auto const & parser) {
                 if (done)
                     return;
+                if (detail::expectation_failed(use_parser.context_)) {
+                    done = true;
+                    success = false;
+                    return;
+                }
                 if (detail::gen_attrs(flags)) {
                     use_parser(parser, retval);
                     if (!success)
@@ -3217,10 +4779,26 @@ namespace boost { namespace parser {
                 else
                     use_parser.first_ = prev_first;
             };
-            detail::hl::for_each(parsers_, try_parser);
+            if constexpr (dispatches<Iter, Context>()) {
+                // Only the alternatives that can match the next char are
+                // tried.
+                uint64_t viable = dispatch(first, last, context);
+                auto try_viable_parser = [&viable,
+                                          &try_parser](auto const & parser) {
+                    bool const is_viable = viable & 1;
+                    viable >>= 1;
+                    if (is_viable)
+                        try_parser(parser);
+                };
+                detail::hl::for_each(parsers_, try_viable_parser);
+            } else {
+                detail::hl::for_each(parsers_, try_parser);
+            }
 
-            if (!done)
+            if (!done) {
                 success = false;
+                first = initial_first;
+            }
         }
 
 #ifndef BOOST_PARSER_DOXYGEN
@@ -3230,9 +4808,42 @@ namespace boost { namespace parser {
         template<typename Parser>
         constexpr auto append(parser_interface<Parser> parser) const noexcept;
 
+        // True if the next char is looked up in dispatch_table_ before any
+        // alternative is tried.  This is not done when tracing, so that the
+        // trace shows every alternative being tried.
+        template<typename Iter, typename Context>
+        static constexpr bool dispatches()
+        {
+            using char_type =
+                detail::remove_cv_ref_t<decltype(*std::declval<Iter &>())>;
+            return !detail::is_nope_v<decltype(dispatch_table_)> &&
+                   std::is_integral_v<char_type> && !Context::do_trace;
+        }
+
+        // Returns a bitmask of the alternatives that can match at first,
+        // based on the next char, in which bit i is set for the i-th
+        // alternative.  All the bits are set if the next char is not ASCII.
+        // first must already have been skipped past.
+        template<typename Iter, typename Sentinel, typename Context>
+        uint64_t dispatch(Iter first, Sentinel last, Context const &) const
+        {
+            // The first sets do not account for case insensitivity.
+            if constexpr (Context::no_case)
+                return ~uint64_t(0);
+            if (first == last)
+                return ~uint64_t(0);
+            using char_type = detail::remove_cv_ref_t<decltype(*first)>;
+            auto const c = std::make_unsigned_t<char_type>(*first);
+            if (128 <= c)
+                return ~uint64_t(0);
+            return dispatch_table_.viable_[c];
+        }
+
 #endif
 
         ParserTuple parsers_;
+        decltype(detail::make_or_dispatch_table(std::declval<ParserTuple>()))
+            dispatch_table_;
     };
 
     namespace detail {
@@ -3853,7 +5464,8 @@ namespace boost { namespace parser {
                 }
             } else {
                 // call_impl requires a tuple, so we must wrap this scalar.
-                tuple<Attribute> temp_retval;
+                auto temp_retval =
+                    detail::make_using_allocator_of<tuple<Attribute>>(retval);
                 call_impl(
                     use_cbs,
                     first,
@@ -3919,7 +5531,7 @@ namespace boost { namespace parser {
                                &retval](auto const &
                                             parser_index_merged_and_backtrack) {
                 using namespace literals;
-                detail::skip(first, last, skip, flags);
+                detail::skip(first, last, skip, flags, context);
                 if (!success) // Someone earlier already failed...
                     return;
 
@@ -3937,11 +5549,8 @@ namespace boost { namespace parser {
                 if (!detail::gen_attrs(flags)) {
                     parser.call(
                         use_cbs, first, last, context, skip, flags, success);
-                    if (!success && !can_backtrack) {
-                        std::stringstream oss;
-                        detail::print_parser(context, parser, oss);
-                        throw parse_error<Iter>(first, oss.str());
-                    }
+                    if (!success && !can_backtrack)
+                        detail::expectation_failure_at(context, first, parser);
                     return;
                 }
 
@@ -3984,9 +5593,8 @@ namespace boost { namespace parser {
                         out);
                     if (!success) {
                         if (!can_backtrack) {
-                            std::stringstream oss;
-                            detail::print_parser(context, parser, oss);
-                            throw parse_error<Iter>(first, oss.str());
+                            detail::expectation_failure_at(
+                                context, first, parser);
                         }
                         out = std::decay_t<decltype(out)>();
                         return;
@@ -3996,9 +5604,8 @@ namespace boost { namespace parser {
                         use_cbs, first, last, context, skip, flags, success);
                     if (!success) {
                         if (!can_backtrack) {
-                            std::stringstream oss;
-                            detail::print_parser(context, parser, oss);
-                            throw parse_error<Iter>(first, oss.str());
+                            detail::expectation_failure_at(
+                                context, first, parser);
                         }
                         return;
                     }
@@ -4171,7 +5778,7 @@ namespace boost { namespace parser {
             typename Sentinel,
             typename Context,
             typename SkipParser>
-        BOOST_PARSER_SUBRANGE<Iter> call(
+        auto call(
             std::bool_constant<UseCallbacks> use_cbs,
             Iter & first,
             Sentinel last,
@@ -4180,9 +5787,18 @@ namespace boost { namespace parser {
             detail::flags flags,
             bool & success) const
         {
-            BOOST_PARSER_SUBRANGE<Iter> retval;
-            call(use_cbs, first, last, context, skip, flags, success, retval);
-            return retval;
+            if constexpr (
+                Context::view_attrs && detail::is_contiguous_char_iter_v<Iter>) {
+                std::string_view retval;
+                call(
+                    use_cbs, first, last, context, skip, flags, success, retval);
+                return retval;
+            } else {
+                BOOST_PARSER_SUBRANGE<Iter> retval;
+                call(
+                    use_cbs, first, last, context, skip, flags, success, retval);
+                return retval;
+            }
         }
 
         template<
@@ -4214,9 +5830,16 @@ namespace boost { namespace parser {
                 skip,
                 detail::disable_attrs(flags),
                 success);
-            if (success && detail::gen_attrs(flags))
+            if (!success || !detail::gen_attrs(flags))
+                return;
+            if constexpr (
+                detail::is_contiguous_char_iter_v<Iter> &&
+                std::is_same_v<Attribute, std::string_view>) {
+                retval = detail::to_string_view(initial_first, first);
+            } else {
                 detail::assign(
                     retval, BOOST_PARSER_SUBRANGE<Iter>(initial_first, first));
+            }
         }
 
         Parser parser_;
@@ -4330,7 +5953,13 @@ namespace boost { namespace parser {
             bool & success) const
         {
             using attr_t = decltype(parser_.call(
-                use_cbs, first, last, context, skip, flags, success));
+                use_cbs,
+                first,
+                last,
+                context,
+                lexeme_skip<Context>(skip),
+                flags,
+                success));
             attr_t retval{};
             call(use_cbs, first, last, context, skip, flags, success, retval);
             return retval;
@@ -4361,12 +5990,89 @@ namespace boost { namespace parser {
                 first,
                 last,
                 context,
-                skip,
+                lexeme_skip<Context>(skip),
                 detail::disable_skip(flags),
                 success,
                 retval);
         }
 
+        // Within views[], the skipper is wrapped, so that repetitions of
+        // chars inside lexeme[] can produce string_views; see
+        // detail::yields_string_view_v.
+        template<typename Context, typename SkipParser>
+        static decltype(auto) lexeme_skip(SkipParser const & skip)
+        {
+            if constexpr (
+                !Context::view_attrs ||
+                std::is_same_v<SkipParser, detail::null_parser> ||
+                detail::is_lexeme_skipper_v<SkipParser>) {
+                return skip;
+            } else {
+                return detail::lexeme_skipper<SkipParser>{skip};
+            }
+        }
+
+        Parser parser_;
+    };
+
+    template<typename Parser>
+    struct views_parser
+    {
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser>
+        auto call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success) const
+        {
+            auto const views_context = detail::make_view_attrs_context(context);
+            using attr_t = decltype(parser_.call(
+                use_cbs, first, last, views_context, skip, flags, success));
+            attr_t retval{};
+            call(use_cbs, first, last, context, skip, flags, success, retval);
+            return retval;
+        }
+
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser,
+            typename Attribute>
+        void call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success,
+            Attribute & retval) const
+        {
+            auto _ = detail::scoped_trace(
+                *this, first, last, context, flags, retval);
+
+            auto const views_context = detail::make_view_attrs_context(context);
+            parser_.call(
+                use_cbs,
+                first,
+                last,
+                views_context,
+                skip,
+                flags,
+                success,
+                retval);
+        }
+
         Parser parser_;
     };
 
@@ -4388,9 +6094,172 @@ namespace boost { namespace parser {
             detail::flags flags,
             bool & success) const
         {
-            auto context = context_;
-            ++context.no_case_depth_;
+            auto const context = detail::make_no_case_context(context_);
+
+            using attr_t = decltype(parser_.call(
+                use_cbs, first, last, context, skip, flags, success));
+            attr_t retval{};
+            call(use_cbs, first, last, context, skip, flags, success, retval);
+            return retval;
+        }
+
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser,
+            typename Attribute>
+        void call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context_,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success,
+            Attribute & retval) const
+        {
+            auto const context = detail::make_no_case_context(context_);
+
+            auto _ = detail::scoped_trace(
+                *this, first, last, context, flags, retval);
+
+            parser_.call(
+                use_cbs, first, last, context, skip, flags, success, retval);
+        }
+
+        Parser parser_;
+    };
+
+    namespace detail {
+        // The position and state of one call to a memoized parser.  Only the
+        // flags that can change the result are kept.  Whether the call is
+        // inside no_case[] is known at compile time, so it selects the table
+        // instead; see memoize_parser::table_for().
+        struct memo_key
+        {
+            std::ptrdiff_t position_;
+            uint32_t flags_;
+
+            friend bool operator==(memo_key lhs, memo_key rhs)
+            {
+                return lhs.position_ == rhs.position_ &&
+                       lhs.flags_ == rhs.flags_;
+            }
+        };
+
+        struct memo_key_hash
+        {
+            std::size_t operator()(memo_key key) const
+            {
+                return std::hash<std::ptrdiff_t>{}(
+                    key.position_ * 4 + key.flags_);
+            }
+        };
+
+        // The results of a memoized parser, for one combination of
+        // attribute type, skipper and context.  A failed parse has no
+        // attribute.
+        template<typename Iter, typename Attr>
+        struct memo_table
+        {
+            struct entry
+            {
+                Iter end_;
+                std::optional<Attr> attr_;
+            };
+            std::unordered_map<memo_key, entry, memo_key_hash> entries_;
+        };
+
+        // The tables for a memoize[p], one for each combination of attribute
+        // type, skipper and context that p is used with.  These are kept in
+        // the same per-parse map as the symbol table tries.
+        using memo_tables = std::map<void const *, any_copyable>;
+
+        // The address of memo_table_id<T> identifies T without RTTI.
+        template<typename T>
+        inline constexpr char memo_table_id = 0;
+
+        template<typename... T>
+        struct memo_table_types
+        {};
+
+        template<typename Parser>
+        constexpr bool is_shared_memo_rule_v = false;
+        template<
+            bool CanUseCallbacks,
+            typename TagType,
+            typename Attribute,
+            typename LocalState>
+        constexpr bool is_shared_memo_rule_v<
+            rule_parser<CanUseCallbacks, TagType, Attribute, LocalState, nope>> =
+            true;
+
+        template<typename Parser>
+        constexpr bool is_parameterized_rule_v = false;
+        template<
+            bool CanUseCallbacks,
+            typename TagType,
+            typename Attribute,
+            typename LocalState,
+            typename ParamsTuple>
+        constexpr bool is_parameterized_rule_v<
+            rule_parser<
+                CanUseCallbacks,
+                TagType,
+                Attribute,
+                LocalState,
+                ParamsTuple>> = !is_nope_v<ParamsTuple>;
+
+        // Whether the results of Parser may depend on the parameters of a
+        // rule, either its own or those of a rule it is used in.  Results
+        // are keyed only by position, so such a parser cannot be memoized.
+        template<typename Parser, typename Context>
+        constexpr bool memo_uses_rule_params_v =
+            is_parameterized_rule_v<Parser> ||
+            !is_nope_v<decltype(std::declval<Context const &>().params_)>;
+
+        // Whether Parser appends to a sequence container attribute, which
+        // may already hold elements (e.g. those merged into it by an
+        // enclosing sequence), rather than replacing it, as a rule does.
+        template<typename Parser, typename Attr>
+        constexpr bool memo_appends_v = is_detected_v<has_push_back, Attr>;
+        template<
+            bool CanUseCallbacks,
+            typename TagType,
+            typename Attribute,
+            typename LocalState,
+            typename ParamsTuple,
+            typename Attr>
+        constexpr bool memo_appends_v<
+            rule_parser<
+                CanUseCallbacks,
+                TagType,
+                Attribute,
+                LocalState,
+                ParamsTuple>,
+            Attr> = false;
+    }
 
+    template<typename Parser>
+    struct memoize_parser
+    {
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser>
+        auto call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success) const
+        {
             using attr_t = decltype(parser_.call(
                 use_cbs, first, last, context, skip, flags, success));
             attr_t retval{};
@@ -4401,31 +6270,154 @@ namespace boost { namespace parser {
         template<
             bool UseCallbacks,
             typename Iter,
-            typename Sentinel,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser,
+            typename Attribute>
+        void call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success,
+            Attribute & retval) const
+        {
+            static_assert(
+                !detail::memo_uses_rule_params_v<Parser, Context>,
+                "memoize[p] cannot be used on a rule with parameters, or "
+                "inside one, because the recorded results of p are not keyed "
+                "by the parameters.  To memoize a rule used with fixed "
+                "parameters, memoize a rule without parameters that uses it.");
+
+            auto _ = detail::scoped_trace(
+                *this, first, last, context, flags, retval);
+
+            // A memoized result would skip the callbacks, and there is no
+            // cheap way to key results by position without random access.
+            if constexpr (UseCallbacks || !detail::has_iter_position_v<Iter>) {
+                parser_.call(
+                    use_cbs, first, last, context, skip, flags, success, retval);
+            } else {
+                constexpr bool appends =
+                    detail::memo_appends_v<Parser, Attribute>;
+                auto & table =
+                    table_for<Iter, Attribute, Context, SkipParser>(context);
+                detail::memo_key const key{
+                    detail::iter_position(context.first_, first),
+                    uint32_t(flags) & (uint32_t(detail::flags::gen_attrs) |
+                                       uint32_t(detail::flags::use_skip))};
+
+                auto const it = table.entries_.find(key);
+                if (it != table.entries_.end()) {
+                    if (stats_)
+                        ++stats_->hits;
+                    first = it->second.end_;
+                    success = it->second.attr_.has_value();
+                    if (success) {
+                        auto const & attr = *it->second.attr_;
+                        if constexpr (appends) {
+                            retval.insert(
+                                retval.end(), attr.begin(), attr.end());
+                        } else {
+                            detail::assign(retval, Attribute(attr));
+                        }
+                    }
+                    return;
+                }
+
+                if (stats_)
+                    ++stats_->misses;
+                std::optional<Attribute> result;
+                if constexpr (appends) {
+                    // Only the elements p appends are cached, so that the
+                    // cached value is independent of whatever retval held
+                    // before.
+                    auto const size = retval.size();
+                    parser_.call(
+                        use_cbs,
+                        first,
+                        last,
+                        context,
+                        skip,
+                        flags,
+                        success,
+                        retval);
+                    if (success) {
+                        result = Attribute(
+                            std::next(retval.begin(), size), retval.end());
+                    }
+                } else {
+                    // Like a rule, p fills in an attribute of its own, which
+                    // then replaces retval.
+                    Attribute attr{};
+                    parser_.call(
+                        use_cbs,
+                        first,
+                        last,
+                        context,
+                        skip,
+                        flags,
+                        success,
+                        attr);
+                    if (success) {
+                        result = attr;
+                        detail::assign(retval, std::move(attr));
+                    }
+                }
+                // A failure that has already been passed to the error
+                // handler must not be replayed as an ordinary failure.
+                if (!detail::expectation_failed(context)) {
+                    if (max_entries_ <= table.entries_.size())
+                        table.entries_.clear();
+                    table.entries_.emplace(
+                        key,
+                        typename detail::memo_table<Iter, Attribute>::entry{
+                            first, std::move(result)});
+                }
+            }
+        }
+
+        // Returns the table of results for this parser, with the given
+        // attribute type, context and skipper, from the per-parse map in
+        // context.
+        template<
+            typename Iter,
+            typename Attr,
             typename Context,
-            typename SkipParser,
-            typename Attribute>
-        void call(
-            std::bool_constant<UseCallbacks> use_cbs,
-            Iter & first,
-            Sentinel last,
-            Context const & context_,
-            SkipParser const & skip,
-            detail::flags flags,
-            bool & success,
-            Attribute & retval) const
-        {
-            auto context = context_;
-            ++context.no_case_depth_;
-
-            auto _ = detail::scoped_trace(
-                *this, first, last, context, flags, retval);
-
-            parser_.call(
-                use_cbs, first, last, context, skip, flags, success, retval);
+            typename SkipParser>
+        detail::memo_table<Iter, Attr> & table_for(Context const & context) const
+        {
+            using table_t = detail::memo_table<Iter, Attr>;
+            // A rule parses the same way everywhere it is used (rules with
+            // parameters are not allowed here), so every memoize[r] shares
+            // r's tables.  Anything else may depend on its context type, so
+            // its tables are its own, and there is one per context type.
+            void const * tables_key = this;
+            void const * table_key = &detail::memo_table_id<
+                detail::memo_table_types<Context, SkipParser, Attr>>;
+            if constexpr (detail::is_shared_memo_rule_v<Parser>) {
+                tables_key = &detail::memo_table_id<typename Parser::tag_type>;
+                table_key = &detail::memo_table_id<detail::memo_table_types<
+                    SkipParser,
+                    Attr,
+                    std::bool_constant<Context::no_case>>>;
+            }
+            detail::any_copyable & tables =
+                (*context.symbol_table_tries_)[(void *)tables_key];
+            if (tables.empty())
+                tables = detail::memo_tables();
+            detail::any_copyable & table =
+                tables.cast<detail::memo_tables>()[table_key];
+            if (table.empty())
+                table = table_t();
+            return table.cast<table_t>();
         }
 
         Parser parser_;
+        std::size_t max_entries_;
+        memoize_stats * stats_;
     };
 
     template<typename Parser, typename SkipParser>
@@ -4447,7 +6439,13 @@ namespace boost { namespace parser {
             bool & success) const
         {
             using attr_t = decltype(parser_.call(
-                use_cbs, first, last, context, skip, flags, success));
+                use_cbs,
+                first,
+                last,
+                context,
+                skipper(skip),
+                flags,
+                success));
             attr_t retval{};
             call(use_cbs, first, last, context, skip, flags, success, retval);
             return retval;
@@ -4473,27 +6471,25 @@ namespace boost { namespace parser {
             auto _ = detail::scoped_trace(
                 *this, first, last, context, flags, retval);
 
-            if constexpr (detail::is_nope_v<SkipParser>) {
-                parser_.call(
-                    use_cbs,
-                    first,
-                    last,
-                    context,
-                    skip,
-                    detail::enable_skip(flags),
-                    success,
-                    retval);
-            } else {
-                parser_.call(
-                    use_cbs,
-                    first,
-                    last,
-                    context,
-                    skip_parser_,
-                    detail::enable_skip(flags),
-                    success,
-                    retval);
-            }
+            parser_.call(
+                use_cbs,
+                first,
+                last,
+                context,
+                skipper(skip),
+                detail::enable_skip(flags),
+                success,
+                retval);
+        }
+
+        // Returns the skipper that p is parsed with.
+        template<typename SkipParser_>
+        decltype(auto) skipper(SkipParser_ const & skip) const
+        {
+            if constexpr (detail::is_nope_v<SkipParser>)
+                return detail::outer_skipper(skip);
+            else
+                return (skip_parser_);
         }
 
         Parser parser_;
@@ -4553,7 +6549,7 @@ namespace boost { namespace parser {
                 detail::disable_attrs(flags),
                 success);
             if (FailOnMatch)
-                success = !success;
+                success = !success && !detail::expectation_failed(context);
         }
 
         Parser parser_;
@@ -4562,23 +6558,27 @@ namespace boost { namespace parser {
     template<typename T>
     struct symbol_parser
     {
+        using trie_t = parser::detail::text::trie<std::vector<char32_t>, T>;
+
         symbol_parser() : copied_from_(nullptr) {}
+        // A copy uses the table of the object it was copied from (see
+        // ref()), so the elements are not copied.  Copies are made each time
+        // the parser is used to build a larger parser, and a table may have
+        // many elements.
         symbol_parser(symbol_parser const & other) :
-            initial_elements_(other.initial_elements_),
             copied_from_(other.copied_from_ ? other.copied_from_ : &other)
         {}
 
         /** Uses UTF-8 string `str` to look up an attribute in the table
             during parsing, returning it as an optional reference.  The lookup
             is done on the copy of the symbol table inside the parse context
-            `context`. */
+            `context`.  `str` is compared exactly, even inside `no_case[]`. */
         template<typename Context>
         parser::detail::text::optional_ref<T>
         find(Context const & context, std::string_view str) const
         {
-            parser::detail::text::trie<std::vector<char32_t>, T> & trie_ =
-                detail::get_trie(context, ref());
-            return trie_[str | detail::text::as_utf32];
+            trie_t & trie = detail::get_mutable_symbols(context, ref()).trie_;
+            return trie[str | detail::text::as_utf32];
         }
 
         /** Inserts an entry consisting of a UTF-8 string `str` to match, and
@@ -4587,9 +6587,8 @@ namespace boost { namespace parser {
         template<typename Context>
         void insert(Context const & context, std::string_view str, T && x) const
         {
-            parser::detail::text::trie<std::vector<char32_t>, T> & trie_ =
-                detail::get_trie(context, ref());
-            trie_.insert(str | detail::text::as_utf32, std::move(x));
+            detail::get_mutable_symbols(context, ref()).insert(
+                str, std::move(x));
         }
 
         /** Erases the entry whose UTF-8 match string is `str` from the copy
@@ -4597,9 +6596,7 @@ namespace boost { namespace parser {
         template<typename Context>
         void erase(Context const & context, std::string_view str) const
         {
-            parser::detail::text::trie<std::vector<char32_t>, T> & trie_ =
-                detail::get_trie(context, ref());
-            trie_.erase(str | detail::text::as_utf32);
+            detail::get_mutable_symbols(context, ref()).erase(str);
         }
 
         template<
@@ -4642,18 +6639,68 @@ namespace boost { namespace parser {
             auto _ = detail::scoped_trace(
                 *this, first, last, context, flags, retval);
 
-            parser::detail::text::trie<std::vector<char32_t>, T> const & trie_ =
-                detail::get_trie(context, ref());
-            auto const lookup = trie_.longest_match(first, last);
-            if (lookup.match) {
-                std::advance(first, lookup.size);
-                detail::assign(retval, T{*trie_[lookup]});
+            auto & table = detail::get_parse_symbol_table(context, ref());
+            if constexpr (Context::no_case) {
+                if (table.local_) {
+                    trie_t const & trie = table.local_->no_case_trie();
+                    auto const [lookup, match_last] =
+                        detail::no_case_longest_match(trie, first, last);
+                    if (lookup.match) {
+                        first = match_last;
+                        detail::assign(retval, T{*trie[lookup]});
+                    } else {
+                        success = false;
+                    }
+                } else {
+                    auto const lookup =
+                        table.snapshot_->no_case_trie().longest_match(
+                            first, last);
+                    if (lookup.value) {
+                        std::advance(first, lookup.size);
+                        detail::assign(retval, T{*lookup.value});
+                    } else {
+                        success = false;
+                    }
+                }
+            } else if (table.local_) {
+                trie_t const & trie = table.local_->trie_;
+                auto const lookup = trie.longest_match(first, last);
+                if (lookup.match) {
+                    std::advance(first, lookup.size);
+                    detail::assign(retval, T{*trie[lookup]});
+                } else {
+                    success = false;
+                }
             } else {
-                success = false;
+                auto const lookup =
+                    table.snapshot_->trie().longest_match(first, last);
+                if (lookup.value) {
+                    std::advance(first, lookup.size);
+                    detail::assign(retval, T{*lookup.value});
+                } else {
+                    success = false;
+                }
             }
         }
 
-        std::vector<std::pair<std::string_view, T>> initial_elements_;
+        void set_initial_elements(
+            std::initializer_list<std::pair<std::string_view, T>> il)
+        {
+            elements_.assign(il);
+        }
+
+        void insert_initial_element(std::string_view str, T x)
+        {
+            elements_.insert(str, std::move(x));
+        }
+
+        // The elements used to start each top-level parse.  Each parse
+        // looks the table up in a snapshot of the elements added before it
+        // began (see detail::get_parse_symbol_table()), so elements added
+        // mid-parse take effect in the next parse.  A parse that mutates the
+        // table via insert() or erase() makes its own copy of that
+        // snapshot.
+        detail::symbol_table_elements<T> elements_;
         symbol_parser const * copied_from_;
 
         symbol_parser const & ref() const noexcept
@@ -4665,7 +6712,7 @@ namespace boost { namespace parser {
         std::vector<std::pair<std::string_view, T>> const &
         initial_elements() const noexcept
         {
-            return ref().initial_elements_;
+            return ref().elements_.elements();
         }
     };
 
@@ -5181,7 +7228,7 @@ namespace boost { namespace parser {
         symbols() {}
         symbols(std::initializer_list<std::pair<std::string_view, T>> il)
         {
-            this->parser_.initial_elements_ = il;
+            this->parser_.set_initial_elements(il);
         }
 
         using parser_interface<symbol_parser<T>>::operator();
@@ -5192,8 +7239,7 @@ namespace boost { namespace parser {
             current top-level parse will not match `str`. */
         symbols & insert_for_next_parse(std::string_view str, T x)
         {
-            this->parser_.initial_elements_.push_back(
-                std::pair<std::string_view, T>(str, std::move(x)));
+            this->parser_.insert_initial_element(str, std::move(x));
             return *this;
         }
 
@@ -5526,6 +7572,11 @@ namespace boost { namespace parser {
         `parser_interface<P>`. */
     inline constexpr directive<lexeme_parser> lexeme;
 
+    /** The `views` directive, whose `operator[]` returns a
+        `parser_interface<views_parser<P>>` from a given parser of type
+        `parser_interface<P>`. */
+    inline constexpr directive<views_parser> views;
+
     /** The `no_case` directive, whose `operator[]` returns a
         `parser_interface<no_case_parser<P>>` from a given parser of type
         `parser_interface<P>`. */
@@ -5604,6 +7655,53 @@ namespace boost { namespace parser {
         `parser_interface<P>`. */
     inline constexpr skip_directive<> skip;
 
+    /** Represents a `memoize_parser` as a directive
+        (e.g. `memoize[other_parser]`).  At most `max_entries_` results are
+        kept for each combination of parser and context; when there are more,
+        the earlier ones are forgotten.  If `stats_` is non-null, the number
+        of hits and misses is added to `*stats_`. */
+    struct memoize_directive
+    {
+        template<typename Parser>
+        constexpr auto operator[](parser_interface<Parser> rhs) const noexcept
+        {
+            return parser_interface{
+                memoize_parser<Parser>{rhs.parser_, max_entries_, stats_}};
+        }
+
+        /** Returns a `memoize_directive` that keeps at most `max_entries`
+            results. */
+        constexpr memoize_directive
+        operator()(std::size_t max_entries) const noexcept
+        {
+            return memoize_directive{max_entries, stats_};
+        }
+
+        /** Returns a `memoize_directive` that counts its hits and misses in
+            `stats`. */
+        constexpr memoize_directive
+        operator()(memoize_stats & stats) const noexcept
+        {
+            return memoize_directive{max_entries_, &stats};
+        }
+
+        /** Returns a `memoize_directive` that keeps at most `max_entries`
+            results, and counts its hits and misses in `stats`. */
+        constexpr memoize_directive operator()(
+            std::size_t max_entries, memoize_stats & stats) const noexcept
+        {
+            return memoize_directive{max_entries, &stats};
+        }
+
+        std::size_t max_entries_ = 1 << 16;
+        memoize_stats * stats_ = nullptr;
+    };
+
+    /** The `memoize_directive`, whose `operator[]` returns a
+        `parser_interface<memoize_parser<P>>` from a given parser of type
+        `parser_interface<P>`. */
+    inline constexpr memoize_directive memoize;
+
     /** A directive type that can only be used on sequence parsers, that
         forces the merge of all the sequence_parser's subparser's attributes
         into a single attribute. */
@@ -6167,18 +8265,31 @@ namespace boost { namespace parser {
         };
     };
 
+    namespace detail {
+        template<typename Tag>
+        constexpr auto make_char_set_table()
+        {
+            constexpr std::size_t stage1_size =
+                detail::code_point_table_stage1_size(
+                    std::begin(char_set<Tag>::chars),
+                    std::end(char_set<Tag>::chars));
+            constexpr std::size_t blocks = detail::code_point_table_blocks(
+                std::begin(char_set<Tag>::chars),
+                std::end(char_set<Tag>::chars));
+            return detail::make_code_point_table<stage1_size, blocks>(
+                std::begin(char_set<Tag>::chars),
+                std::end(char_set<Tag>::chars));
+        }
+
+        // The code points in char_set<Tag>::chars, built at compile time.
+        template<typename Tag>
+        inline constexpr auto char_set_table = make_char_set_table<Tag>();
+    }
+
     template<typename Tag>
     struct char_set_parser
     {
-        BOOST_PARSER_ALGO_CONSTEXPR char_set_parser()
-        {
-            auto const & chars = detail::char_set<Tag>::chars;
-            auto const first = std::begin(chars);
-            auto const last = std::end(chars);
-            auto it = std::upper_bound(first, last, 0x100);
-            if (it != last)
-                one_byte_offset_ = it - first;
-        }
+        constexpr char_set_parser() {}
 
         template<typename T>
         using attribute_t = std::decay_t<T>;
@@ -6228,26 +8339,9 @@ namespace boost { namespace parser {
                 return;
             }
 
-            auto const & chars = detail::char_set<Tag>::chars;
             attribute_t<decltype(*first)> const x = *first;
             uint32_t const x_cmp = x;
-            if (x_cmp < U'\x0100') {
-                uint32_t const * it = std::lower_bound(
-                    std::begin(chars),
-                    std::begin(chars) + one_byte_offset_,
-                    x_cmp);
-                if (it != std::end(chars) && *it == x_cmp) {
-                    detail::assign(retval, x_cmp);
-                    ++first;
-                } else {
-                    success = false;
-                }
-                return;
-            }
-
-            uint32_t const * it = std::lower_bound(
-                std::begin(chars) + one_byte_offset_, std::end(chars), x_cmp);
-            if (it != std::end(chars) && *it == x_cmp) {
+            if (detail::char_set_table<Tag>.contains(x_cmp)) {
                 detail::assign(retval, x_cmp);
                 ++first;
                 return;
@@ -6255,8 +8349,6 @@ namespace boost { namespace parser {
 
             success = false;
         }
-
-        int one_byte_offset_ = 0;
     };
 
     template<typename Tag>
@@ -6363,7 +8455,12 @@ namespace boost { namespace parser {
     template<typename StrIter, typename StrSentinel>
     struct string_parser
     {
-        constexpr string_parser() : expected_first_(), expected_last_() {}
+        constexpr string_parser() :
+            expected_first_(),
+            expected_last_(),
+            char_size_(detail::is_contiguous_char_iter_v<StrIter> ? 0 : -1),
+            ascii_(detail::is_contiguous_char_iter_v<StrIter>)
+        {}
 
 #if BOOST_PARSER_USE_CONCEPTS
         template<parsable_range_like R>
@@ -6375,7 +8472,10 @@ namespace boost { namespace parser {
 #endif
         constexpr string_parser(R && r) :
             expected_first_(detail::make_view_begin(r)),
-            expected_last_(detail::make_view_end(r))
+            expected_last_(detail::make_view_end(r)),
+            char_size_(
+                detail::contiguous_char_size(expected_first_, expected_last_)),
+            ascii_(detail::is_ascii_chars(expected_first_, expected_last_))
         {}
 
         template<
@@ -6426,16 +8526,34 @@ namespace boost { namespace parser {
             if constexpr (std::is_same_v<
                               detail::remove_cv_ref_t<decltype(*first)>,
                               char32_t>) {
+                if constexpr (
+                    !Context::no_case &&
+                    detail::is_contiguous_char_iter_v<StrIter>) {
+                    // Each char of an ASCII string is a code point, so it
+                    // need not be transcoded.
+                    if (ascii_) {
+                        Iter it = first;
+                        for (std::ptrdiff_t i = 0; i < char_size_; ++i, ++it) {
+                            if (it == last ||
+                                *it != (char32_t)expected_first_[i]) {
+                                success = false;
+                                return;
+                            }
+                        }
+                        detail::append(
+                            retval, first, it, detail::gen_attrs(flags));
+                        first = it;
+                        return;
+                    }
+                }
+
                 auto const cps =
                     BOOST_PARSER_SUBRANGE(expected_first_, expected_last_) |
                     detail::text::as_utf32;
 
-                auto const mismatch = detail::no_case_aware_string_mismatch(
-                    first,
-                    last,
-                    cps.begin(),
-                    cps.end(),
-                    context.no_case_depth_);
+                auto const mismatch =
+                    detail::no_case_aware_string_mismatch<Context::no_case>(
+                        first, last, cps.begin(), cps.end());
                 if (mismatch.second != cps.end()) {
                     success = false;
                     return;
@@ -6446,12 +8564,55 @@ namespace boost { namespace parser {
 
                 first = mismatch.first;
             } else {
-                auto const mismatch = detail::no_case_aware_string_mismatch(
-                    first,
-                    last,
-                    expected_first_,
-                    expected_last_,
-                    context.no_case_depth_);
+                if constexpr (
+                    detail::is_contiguous_char_iter_v<StrIter> &&
+                    detail::is_contiguous_char_iter_v<Iter> &&
+                    std::is_same_v<Iter, Sentinel>) {
+                    if constexpr (!Context::no_case) {
+                        if (last - first < char_size_ ||
+                            (char_size_ &&
+                             std::memcmp(
+                                 detail::to_char_pointer(first),
+                                 detail::to_char_pointer(expected_first_),
+                                 char_size_))) {
+                            success = false;
+                            return;
+                        }
+                        Iter const match_last = first + char_size_;
+                        detail::append(
+                            retval,
+                            first,
+                            match_last,
+                            detail::gen_attrs(flags));
+                        first = match_last;
+                        return;
+                    } else if (
+                        ascii_ && 0 < char_size_ &&
+                        char_size_ <= last - first) {
+                        auto const result = detail::ascii_no_case_compare(
+                            detail::to_char_pointer(first),
+                            detail::to_char_pointer(expected_first_),
+                            char_size_);
+                        if (result == detail::ascii_no_case_result::mismatch) {
+                            success = false;
+                            return;
+                        }
+                        if (result == detail::ascii_no_case_result::match) {
+                            Iter const match_last = first + char_size_;
+                            detail::append(
+                                retval,
+                                first,
+                                match_last,
+                                detail::gen_attrs(flags));
+                            first = match_last;
+                            return;
+                        }
+                    }
+                }
+
+                auto const mismatch =
+                    detail::no_case_aware_string_mismatch<Context::no_case>(
+                        first, last, expected_first_, expected_last_);
                 if (mismatch.second != expected_last_) {
                     success = false;
                     return;
@@ -6466,6 +8627,13 @@ namespace boost { namespace parser {
 
         StrIter expected_first_;
         StrSentinel expected_last_;
+        // The length of the expected string in chars, if its chars are
+        // contiguous, or -1.  Such a string is compared to contiguous char
+        // input with one bounds check and a memcmp(), or under no_case[],
+        // if it is all ASCII, a block of chars at a time.
+        std::ptrdiff_t char_size_;
+        // True iff the expected string's chars are contiguous and all ASCII.
+        bool ascii_;
     };
 
 #if BOOST_PARSER_USE_CONCEPTS
@@ -6650,21 +8818,20 @@ namespace boost { namespace parser {
     /** The punctuation character parser.  Matches the full set of Unicode
         punctuation clases (specifically, "Pc", "Pd", "Pe", "Pf", "Pi", "Ps",
         and "Po"). */
-    inline BOOST_PARSER_ALGO_CONSTEXPR
-        parser_interface<char_set_parser<detail::punct_chars>>
-            punct;
+    inline constexpr parser_interface<char_set_parser<detail::punct_chars>>
+        punct;
 
     /** The lower case character parser.  Matches the full set of Unicode
         lower case code points (class "Ll"). */
-    inline BOOST_PARSER_ALGO_CONSTEXPR
-        parser_interface<char_set_parser<detail::lower_case_chars>>
-            lower;
+    inline constexpr parser_interface<
+        char_set_parser<detail::lower_case_chars>>
+        lower;
 
     /** The lower case character parser.  Matches the full set of Unicode
         lower case code points (class "Lu"). */
-    inline BOOST_PARSER_ALGO_CONSTEXPR
-        parser_interface<char_set_parser<detail::upper_case_chars>>
-            upper;
+    inline constexpr parser_interface<
+        char_set_parser<detail::upper_case_chars>>
+        upper;
 
     struct bool_parser
     {
@@ -6708,12 +8875,13 @@ namespace boost { namespace parser {
             auto _ = detail::scoped_trace(
                 *this, first, last, context, flags, retval);
 
-            auto compare =
-                [no_case = context.no_case_depth_](char32_t a, char32_t b) {
-                    if (no_case && 0x41 <= b && b < 0x5b)
+            auto compare = [](char32_t a, char32_t b) {
+                if constexpr (Context::no_case) {
+                    if (0x41 <= b && b < 0x5b)
                         b += 0x20;
-                    return a == b;
-                };
+                }
+                return a == b;
+            };
 
             // The lambda quiets a signed/unsigned mismatch warning when
             // comparing the chars here to code points.
@@ -6795,7 +8963,17 @@ namespace boost { namespace parser {
             using extract =
                 detail_spirit_x3::extract_uint<T, Radix, MinDigits, MaxDigits>;
             T attr = 0;
-            success = extract::call(first, last, attr);
+            if constexpr (detail::use_parse_int_fast_v<
+                              T,
+                              Radix,
+                              MinDigits,
+                              MaxDigits,
+                              Iter,
+                              Sentinel>) {
+                success = detail::parse_int_fast<extract>(first, last, attr);
+            } else {
+                success = extract::call(first, last, attr);
+            }
             if (attr != detail::resolve(context, expected_))
                 success = false;
             if (success)
@@ -6907,7 +9085,17 @@ namespace boost { namespace parser {
                 detail_spirit_x3::extract_int<T, Radix, MinDigits, MaxDigits>;
             T attr = 0;
             auto const initial = first;
-            success = extract::call(first, last, attr);
+            if constexpr (detail::use_parse_int_fast_v<
+                              T,
+                              Radix,
+                              MinDigits,
+                              MaxDigits,
+                              Iter,
+                              Sentinel>) {
+                success = detail::parse_int_fast<extract>(first, last, attr);
+            } else {
+                success = extract::call(first, last, attr);
+            }
             if (first == initial || attr != detail::resolve(context, expected_))
                 success = false;
             if (success)
@@ -6947,7 +9135,7 @@ namespace boost { namespace parser {
         particular value `x`, use `long_long(x)`. */
     inline constexpr parser_interface<int_parser<long long>> long_long;
 
-    template<typename T>
+    template<typename T, bool CorrectlyRounded>
     struct float_parser
     {
         constexpr float_parser() {}
@@ -6991,12 +9179,16 @@ namespace boost { namespace parser {
         {
             auto _ = detail::scoped_trace(
                 *this, first, last, context, flags, retval);
-            detail_spirit_x3::real_policies<T> policies;
-            using extract = detail_spirit_x3::
-                extract_real<T, detail_spirit_x3::real_policies<T>>;
             T attr = 0;
             auto const initial = first;
-            success = extract::parse(first, last, attr, policies);
+            if constexpr (CorrectlyRounded) {
+                success = detail::parse_real_precise(first, last, attr);
+            } else {
+                detail_spirit_x3::real_policies<T> policies;
+                using extract = detail_spirit_x3::
+                    extract_real<T, detail_spirit_x3::real_policies<T>>;
+                success = extract::parse(first, last, attr, policies);
+            }
             if (first == initial)
                 success = false;
             if (success)
@@ -7004,12 +9196,80 @@ namespace boost { namespace parser {
         }
     };
 
+    template<typename T>
+    struct json_number_parser
+    {
+        constexpr json_number_parser() {}
+
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser>
+        T call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success) const
+        {
+            T retval;
+            call(use_cbs, first, last, context, skip, flags, success, retval);
+            return retval;
+        }
+
+        template<
+            bool UseCallbacks,
+            typename Iter,
+            typename Sentinel,
+            typename Context,
+            typename SkipParser,
+            typename Attribute>
+        void call(
+            std::bool_constant<UseCallbacks> use_cbs,
+            Iter & first,
+            Sentinel last,
+            Context const & context,
+            SkipParser const & skip,
+            detail::flags flags,
+            bool & success,
+            Attribute & retval) const
+        {
+            auto _ = detail::scoped_trace(
+                *this, first, last, context, flags, retval);
+            T attr = 0;
+            success = detail::parse_real_precise<true>(first, last, attr);
+            if (success)
+                detail::assign(retval, attr);
+        }
+    };
+
     /** The `float` parser.  Produces a `float` attribute. */
     inline constexpr parser_interface<float_parser<float>> float_;
 
     /** The `double` parser.  Produces a `double` attribute. */
     inline constexpr parser_interface<float_parser<double>> double_;
 
+    /** The correctly-rounded `float` parser.  Matches the same inputs as
+        `float_`, and produces a correctly-rounded `float` attribute; see
+        `float_parser`. */
+    inline constexpr parser_interface<float_parser<float, true>>
+        precise_float_;
+
+    /** The correctly-rounded `double` parser.  Matches the same inputs as
+        `double_`, and produces a correctly-rounded `double` attribute; see
+        `float_parser`. */
+    inline constexpr parser_interface<float_parser<double, true>>
+        precise_double_;
+
+    /** The JSON number parser.  Matches only numbers in the syntax JSON
+        allows, and produces a correctly-rounded `double` attribute, in one
+        pass over the input; see `json_number_parser`. */
+    inline constexpr parser_interface<json_number_parser<double>> json_number;
+
 
     /** Represents a sequence parser, the first parser of which is an
         `epsilon_parser` with predicate, as a directive
@@ -7610,8 +9870,9 @@ namespace boost { namespace parser {
         typename GlobalState,
         typename ErrorHandler,
         typename Attr,
-        typename Enable =
-            std::enable_if_t<detail::is_parsable_range_like_v<R>>>
+        typename Enable = std::enable_if_t<
+            detail::is_parsable_range_like_v<R> &&
+            !detail::is_memory_resource_pointer_v<Attr>>>
 #endif
     bool parse(
         R const & r,
@@ -7624,7 +9885,8 @@ namespace boost { namespace parser {
             ErrorHandler,
             std::ranges::iterator_t<decltype(detail::make_input_subrange(r))>,
             std::ranges::sentinel_t<decltype(detail::make_input_subrange(r))>,
-            GlobalState>
+            GlobalState> &&
+            (!detail::is_memory_resource_pointer_v<Attr>)
     // clang-format on
 #endif
     {
@@ -7834,7 +10096,9 @@ namespace boost { namespace parser {
         typename ErrorHandler,
         typename SkipParser,
         typename Attr,
-        typename Enable = std::enable_if_t<detail::is_parsable_range_like_v<R>>>
+        typename Enable = std::enable_if_t<
+            detail::is_parsable_range_like_v<R> &&
+            !detail::is_memory_resource_pointer_v<Attr>>>
 #endif
     bool parse(
         R const & r,
@@ -7848,7 +10112,8 @@ namespace boost { namespace parser {
             ErrorHandler,
             std::ranges::iterator_t<decltype(detail::make_input_subrange(r))>,
             std::ranges::sentinel_t<decltype(detail::make_input_subrange(r))>,
-            GlobalState>
+            GlobalState> &&
+            (!detail::is_memory_resource_pointer_v<Attr>)
     // clang-format on
 #endif
     {
@@ -8179,6 +10444,102 @@ namespace boost { namespace parser {
             parser::prefix_parse(first, last, parser, skip, trace_mode));
     }
 
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+
+    /** Parses `r` using `parser`.  Returns a `std::optional` containing the
+        attribute produced by `parser` on parse success, and `std::nullopt` on
+        parse failure.  The attribute is the one `parse(r, parser)` would
+        produce, except that each `std::basic_string` and `std::vector` in it
+        (including those nested inside other containers and tuples) is the
+        corresponding `std::pmr` container, and allocates from `resource`.
+        The entire input range `r` must be consumed for the parse to be
+        considered successful.  If `trace_mode == trace::on`, a verbose trace
+        of the parse will be streamed to `std::cout`. */
+#if BOOST_PARSER_USE_CONCEPTS
+    template<
+        parsable_range_like R,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler>
+#else
+    template<
+        typename R,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename Enable = std::enable_if_t<detail::is_parsable_range_like_v<R>>>
+#endif
+    auto parse(
+        R const & r,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        std::pmr::memory_resource * resource,
+        trace trace_mode = trace::off)
+    {
+        using result_t = decltype(parser::parse(r, parser, trace_mode));
+        static_assert(
+            !std::is_same_v<result_t, bool>,
+            "If you're seeing this error, you're trying to get parse() to "
+            "allocate the attribute produced by parser from a memory "
+            "resource.  However, parser does not generate an attribute.");
+        using attr_t = detail::pmr_attribute_t<typename result_t::value_type>;
+        attr_t attr = detail::make_using_allocator<attr_t>(
+            std::pmr::polymorphic_allocator<std::byte>(resource));
+        std::optional<attr_t> retval;
+        if (parser::parse(r, parser, attr, trace_mode))
+            retval.emplace(std::move(attr));
+        return retval;
+    }
+
+    /** Parses `r` using `parser`, skipping all input recognized by `skip`
+        between the application of any two parsers.  Returns a `std::optional`
+        containing the attribute produced by `parser` on parse success, and
+        `std::nullopt` on parse failure.  The attribute is the one
+        `parse(r, parser, skip)` would produce, except that each
+        `std::basic_string` and `std::vector` in it is the corresponding
+        `std::pmr` container, and allocates from `resource`.  The entire input
+        range `r` must be consumed for the parse to be considered successful.
+        If `trace_mode == trace::on`, a verbose trace of the parse will be
+        streamed to `std::cout`. */
+#if BOOST_PARSER_USE_CONCEPTS
+    template<
+        parsable_range_like R,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser>
+#else
+    template<
+        typename R,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser,
+        typename Enable = std::enable_if_t<detail::is_parsable_range_like_v<R>>>
+#endif
+    auto parse(
+        R const & r,
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        SkipParser const & skip,
+        std::pmr::memory_resource * resource,
+        trace trace_mode = trace::off)
+    {
+        using result_t = decltype(parser::parse(r, parser, skip, trace_mode));
+        static_assert(
+            !std::is_same_v<result_t, bool>,
+            "If you're seeing this error, you're trying to get parse() to "
+            "allocate the attribute produced by parser from a memory "
+            "resource.  However, parser does not generate an attribute.");
+        using attr_t = detail::pmr_attribute_t<typename result_t::value_type>;
+        attr_t attr = detail::make_using_allocator<attr_t>(
+            std::pmr::polymorphic_allocator<std::byte>(resource));
+        std::optional<attr_t> retval;
+        if (parser::parse(r, parser, skip, attr, trace_mode))
+            retval.emplace(std::move(attr));
+        return retval;
+    }
+
 #endif
 
     /** Parses `[first, last)` using `parser`, and returns whether the parse
@@ -9,6 +9,7 @@
 #include <boost/parser/config.hpp>
 #include <boost/parser/error_handling_fwd.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -117,10 +118,29 @@ namespace boost { namespace parser {
             std::unique_ptr<holder_base> impl_;
         };
 
-        using symbol_table_tries_t =
-            std::map<void *, any_copyable, std::less<void *>>;
+        /** The number of elements added to any `symbols<T>` via
+            `insert_for_next_parse()` so far. */
+        inline std::atomic<std::uint64_t> symbol_table_generation{0};
 
-        template<typename Iter, typename Sentinel, typename ErrorHandler>
+        /** The state of the symbol tables used in one top-level parse, keyed
+            by table.  `generation_` is the value of
+            `symbol_table_generation` when the parse began; elements added
+            to a table after that are not seen by the parse. */
+        struct symbol_table_tries_t
+            : std::map<void *, any_copyable, std::less<void *>>
+        {
+            symbol_table_tries_t() :
+                generation_(symbol_table_generation.load())
+            {}
+
+            std::uint64_t generation_;
+        };
+
+        template<
+            bool DoTrace = false,
+            typename Iter,
+            typename Sentinel,
+            typename ErrorHandler>
         inline auto make_context(
             Iter first,
             Sentinel last,
@@ -263,6 +283,16 @@ namespace boost { namespace parser {
     template<typename Parser>
     struct lexeme_parser;
 
+    /** Applies the given parser `p` of type `Parser`.  Within `p`, when the
+        input is a contiguous sequence of `char`, each undelimited repetition
+        of a parser that matches a single `char` (such as `char_`, or `char_
+        - ','`), in which nothing is skipped, produces a `std::string_view`
+        of the matched input instead of a `std::string`, and `raw[]` produces
+        a `std::string_view` instead of a subrange.  The parse succeeds iff
+        `p` succeeds. */
+    template<typename Parser>
+    struct views_parser;
+
     /** Applies the given parser `p` of type `Parser`, enabling
         case-insensitive matching, based on Unicode case folding.  The parse
         succeeds iff `p` succeeds.  The attribute produced is the type of
@@ -270,6 +300,23 @@ namespace boost { namespace parser {
     template<typename Parser>
     struct no_case_parser;
 
+    /** Counts of the calls to a `memoize[p]` that were answered from its
+        table of earlier results (`hits`) and of those that had to apply `p`
+        (`misses`). */
+    struct memoize_stats
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+    /** Applies the given parser `p` of type `Parser`, recording the result
+        of `p` at each position in the input, and reusing the recorded
+        result when `p` is tried again at the same position.  The parse
+        succeeds iff `p` succeeds.  The attribute produced is the type of
+        attribute produced by `Parser`. */
+    template<typename Parser>
+    struct memoize_parser;
+
     /** Applies the given parser `p` of type `Parser`, using a parser of type
         `SkipParser` as the skipper.  The parse succeeds iff `p` succeeds.
         The attribute produced is the type of attribute produced by
@@ -410,10 +457,24 @@ namespace boost { namespace parser {
     struct int_parser;
 
     /** Matches a floating point number, producing an attribute of type
-        `T`. */
-    template<typename T>
+        `T`.  If `CorrectlyRounded` is `true`, the result is always correctly
+        rounded, where `std::from_chars()` supports floating point types;
+        most numbers are converted exactly as they are scanned, and the rest
+        using `std::from_chars()`.  This takes about as long as the default
+        conversion, which is not always correctly rounded. */
+    template<typename T, bool CorrectlyRounded = false>
     struct float_parser;
 
+    /** Matches a number in the syntax JSON allows, producing an attribute of
+        type `T`.  This is stricter than `float_parser`: there must be digits
+        before and after any `.`, there is no leading `+`, only the `0` of
+        `01` is matched, and `inf` and `nan` are not matched.  The matched
+        characters are converted as `float_parser<T, true>` converts them,
+        except that a number too large for `T` produces infinity (with the
+        number's sign), as `std::strtod()` does, instead of not matching. */
+    template<typename T>
+    struct json_number_parser;
+
     /** Applies at most one of the parsers in `OrParser`.  If `switch_value_`
         matches one or more of the values in the parsers in `OrParser`, the
         first such parser is applied, and the success or failure and attribute
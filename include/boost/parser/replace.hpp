@@ -239,7 +239,8 @@ namespace boost::parser {
             replacement_(std::move(replacement)),
             parser_(parser),
             skip_(skip),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
         constexpr replace_view(
             V base,
@@ -250,7 +251,8 @@ namespace boost::parser {
             replacement_(std::move(replacement)),
             parser_(parser),
             skip_(),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
 
         constexpr V base() const &
@@ -325,11 +327,12 @@ namespace boost::parser {
             {
                 if (in_match_) {
                     r_ = BOOST_PARSER_SUBRANGE<I, S>(next_it_, r_.end());
-                    auto const new_match = parser::search(
+                    auto const new_match = detail::search_repack_shim(
                         r_,
                         parent_->parser_,
                         parent_->skip_,
-                        parent_->trace_mode_);
+                        parent_->trace_mode_,
+                        parent_->prefilter_.get());
                     if (new_match.begin() == curr_.end()) {
                         curr_ = new_match;
                     } else {
@@ -393,6 +396,7 @@ namespace boost::parser {
         parser_interface<Parser, GlobalState, ErrorHandler> parser_;
         parser_interface<SkipParser> skip_;
         trace trace_mode_;
+        std::shared_ptr<detail::search_prefilter const> prefilter_;
     };
 
     // deduction guides
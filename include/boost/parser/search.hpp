@@ -3,8 +3,14 @@
 
 #include <boost/parser/parser.hpp>
 #include <boost/parser/transcode_view.hpp>
+#include <boost/parser/detail/aho_corasick.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
 
 
 namespace boost::parser {
@@ -88,6 +94,413 @@ namespace boost::parser {
         struct phony
         {};
 
+        // What search() knows about where a match can begin, found by
+        // looking at the front of a parser.  If valid is false, a match may
+        // begin anywhere.
+        struct search_prefilter
+        {
+            // A match must begin with one of these chars.
+            std::array<bool, 256> first_chars = {};
+            // A match must begin with one of these, if strings_valid is
+            // true.  Used only while the prefilter is being made.
+            std::vector<std::string> strings;
+            bool strings_valid = false;
+            bool valid = false;
+
+            void add(char c) { first_chars[(unsigned char)c] = true; }
+            void add(std::string str)
+            {
+                add(str[0]);
+                strings.push_back(std::move(str));
+                strings_valid = true;
+            }
+
+            // Picks the way find() looks for a match, once the whole parser
+            // has been looked at.  A single string is found with memchr()
+            // and memcmp(), and several strings with an Aho-Corasick
+            // automaton, unless they are all one char long.
+            void finish()
+            {
+                if (strings_valid && strings.size() == 1) {
+                    prefix = std::move(strings[0]);
+                } else if (
+                    strings_valid &&
+                    std::any_of(
+                        strings.begin(),
+                        strings.end(),
+                        [](std::string const & str) {
+                            return 1u < str.size();
+                        })) {
+                    automaton =
+                        std::make_shared<aho_corasick const>(std::move(strings));
+                }
+                strings.clear();
+                strings_valid = false;
+            }
+
+            // Returns the first position in [first, last) at which a match
+            // can begin, or last.
+            char const * find(char const * first, char const * last) const
+            {
+                if (automaton)
+                    return automaton->find(first, last);
+                if (!prefix.empty()) {
+                    std::size_t const n = prefix.size();
+                    while (n <= std::size_t(last - first)) {
+                        auto const it = (char const *)std::memchr(
+                            first, prefix[0], last - first - (n - 1));
+                        if (!it)
+                            break;
+                        if (!std::memcmp(it + 1, prefix.data() + 1, n - 1))
+                            return it;
+                        first = it + 1;
+                    }
+                    return last;
+                }
+                for (; first != last; ++first) {
+                    if (first_chars[(unsigned char)*first])
+                        return first;
+                }
+                return last;
+            }
+
+            std::string prefix;
+            std::shared_ptr<aho_corasick const> automaton;
+        };
+
+        // Only parsers that consume at least one char, and whose first char
+        // is known, get a valid prefilter.  Parsers that contain a rule,
+        // no_case[], a lazy value, or anything else not handled here do not.
+        template<typename Parser>
+        struct search_prefilter_maker
+        {
+            static search_prefilter call(Parser const &) { return {}; }
+        };
+
+        template<typename Parser>
+        search_prefilter make_search_prefilter(Parser const & parser)
+        {
+            return search_prefilter_maker<Parser>::call(parser);
+        }
+
+        template<typename AttributeType>
+        struct search_prefilter_maker<char_parser<char, AttributeType>>
+        {
+            static search_prefilter
+            call(char_parser<char, AttributeType> const & parser)
+            {
+                search_prefilter retval;
+                retval.add(std::string(1, parser.expected_));
+                retval.valid = true;
+                return retval;
+            }
+        };
+
+        template<typename AttributeType>
+        struct search_prefilter_maker<
+            char_parser<char_pair<char, char>, AttributeType>>
+        {
+            static search_prefilter call(
+                char_parser<char_pair<char, char>, AttributeType> const &
+                    parser)
+            {
+                search_prefilter retval;
+                for (int i = 0; i < 256; ++i) {
+                    char const c = (char)i;
+                    if (parser.expected_.lo_ <= c && c <= parser.expected_.hi_)
+                        retval.add(c);
+                }
+                retval.valid = true;
+                return retval;
+            }
+        };
+
+        template<typename Iter, typename Sentinel, typename AttributeType>
+        struct search_prefilter_maker<
+            char_parser<char_range<Iter, Sentinel, false>, AttributeType>>
+        {
+            static search_prefilter call(
+                char_parser<char_range<Iter, Sentinel, false>, AttributeType> const &
+                    parser)
+            {
+                search_prefilter retval;
+                if constexpr (std::is_same_v<
+                                  remove_cv_ref_t<decltype(*std::declval<Iter>())>,
+                                  char>) {
+                    for (char c : parser.expected_.chars_) {
+                        retval.add(c);
+                    }
+                    retval.valid = true;
+                }
+                return retval;
+            }
+        };
+
+        template<typename StrIter, typename StrSentinel>
+        struct search_prefilter_maker<string_parser<StrIter, StrSentinel>>
+        {
+            static search_prefilter
+            call(string_parser<StrIter, StrSentinel> const & parser)
+            {
+                search_prefilter retval;
+                if constexpr (is_contiguous_char_iter_v<StrIter>) {
+                    std::size_t n = 0;
+                    for (auto it = parser.expected_first_;
+                         it != parser.expected_last_;
+                         ++it) {
+                        ++n;
+                    }
+                    if (n) {
+                        retval.add(std::string(
+                            detail::to_char_pointer(parser.expected_first_),
+                            n));
+                        retval.valid = true;
+                    }
+                }
+                return retval;
+            }
+        };
+
+        template<typename T>
+        struct search_prefilter_maker<symbol_parser<T>>
+        {
+            static search_prefilter call(symbol_parser<T> const & parser)
+            {
+                // Symbols are matched code point by code point, so on char
+                // input only a symbol that starts with an ASCII char can
+                // match.  Give up on anything else, rather than reason about
+                // it.  Likewise, the symbols are used as strings of chars
+                // only if they are all ASCII.
+                search_prefilter retval;
+                bool all_ascii = true;
+                for (auto const & [str, x] : parser.initial_elements()) {
+                    if (str.empty() || 0x80 <= (unsigned char)str[0])
+                        return {};
+                    all_ascii =
+                        all_ascii &&
+                        std::all_of(str.begin(), str.end(), [](char c) {
+                            return (unsigned char)c < 0x80;
+                        });
+                    if (all_ascii)
+                        retval.add(std::string(str));
+                    else
+                        retval.add(str[0]);
+                }
+                retval.strings_valid = all_ascii;
+                retval.valid = true;
+                return retval;
+            }
+        };
+
+        template<typename Parser>
+        struct search_prefilter_maker<omit_parser<Parser>>
+        {
+            static search_prefilter call(omit_parser<Parser> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+
+        template<typename Parser>
+        struct search_prefilter_maker<raw_parser<Parser>>
+        {
+            static search_prefilter call(raw_parser<Parser> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+
+#if defined(__cpp_lib_concepts)
+        template<typename Parser>
+        struct search_prefilter_maker<string_view_parser<Parser>>
+        {
+            static search_prefilter
+            call(string_view_parser<Parser> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+#endif
+
+        template<typename Parser>
+        struct search_prefilter_maker<lexeme_parser<Parser>>
+        {
+            static search_prefilter call(lexeme_parser<Parser> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+
+        template<typename Parser>
+        struct search_prefilter_maker<views_parser<Parser>>
+        {
+            static search_prefilter call(views_parser<Parser> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+
+        template<typename Parser, typename Action>
+        struct search_prefilter_maker<action_parser<Parser, Action>>
+        {
+            static search_prefilter
+            call(action_parser<Parser, Action> const & parser)
+            {
+                return detail::make_search_prefilter(parser.parser_);
+            }
+        };
+
+        template<
+            typename Parser,
+            typename DelimiterParser,
+            typename MinType,
+            typename MaxType>
+        struct search_prefilter_maker<
+            repeat_parser<Parser, DelimiterParser, MinType, MaxType>>
+        {
+            static search_prefilter call(
+                repeat_parser<Parser, DelimiterParser, MinType, MaxType> const &
+                    parser)
+            {
+                if constexpr (std::is_integral_v<MinType>) {
+                    if (1 <= parser.min_)
+                        return detail::make_search_prefilter(parser.parser_);
+                }
+                return {};
+            }
+        };
+
+        template<typename Parser>
+        struct search_prefilter_maker<one_plus_parser<Parser>>
+            : search_prefilter_maker<repeat_parser<Parser>>
+        {};
+
+        template<typename Parser, typename DelimiterParser>
+        struct search_prefilter_maker<
+            delimited_seq_parser<Parser, DelimiterParser>>
+            : search_prefilter_maker<repeat_parser<Parser, DelimiterParser>>
+        {};
+
+        template<
+            typename ParserTuple,
+            typename BacktrackingTuple,
+            typename CombiningGroups>
+        struct search_prefilter_maker<
+            seq_parser<ParserTuple, BacktrackingTuple, CombiningGroups>>
+        {
+            static search_prefilter
+            call(seq_parser<ParserTuple, BacktrackingTuple, CombiningGroups> const &
+                     parser)
+            {
+                return detail::make_search_prefilter(
+                    parser::get(parser.parsers_, llong<0>{}));
+            }
+        };
+
+        template<typename ParserTuple>
+        struct search_prefilter_maker<or_parser<ParserTuple>>
+        {
+            static search_prefilter call(or_parser<ParserTuple> const & parser)
+            {
+                search_prefilter retval;
+                retval.valid = true;
+                retval.strings_valid = true;
+                detail::hl::for_each(parser.parsers_, [&](auto const & p) {
+                    auto const alternative = detail::make_search_prefilter(p);
+                    retval.valid = retval.valid && alternative.valid;
+                    retval.strings_valid =
+                        retval.strings_valid && alternative.strings_valid;
+                    retval.strings.insert(
+                        retval.strings.end(),
+                        alternative.strings.begin(),
+                        alternative.strings.end());
+                    for (int i = 0; i < 256; ++i) {
+                        retval.first_chars[i] = retval.first_chars[i] ||
+                                                alternative.first_chars[i];
+                    }
+                });
+                return retval;
+            }
+        };
+
+        // Iter is used to find a match with a prefilter, if it is a
+        // contiguous char iterator.
+        template<typename Iter, typename Sentinel, typename SkipParser>
+        constexpr bool use_search_prefilter_v =
+            is_contiguous_char_iter_v<Iter> &&
+            std::is_same_v<Iter, Sentinel> &&
+            std::is_same_v<SkipParser, eps_parser<phony>>;
+
+        template<typename Parser>
+        search_prefilter search_prefilter_for(Parser const & parser)
+        {
+            search_prefilter retval = detail::make_search_prefilter(parser);
+            retval.finish();
+            return retval;
+        }
+
+        // The search-based views make the prefilter for their parser once,
+        // and use it for every search they do.  Making it can be costly; it
+        // may build an automaton out of a large symbol table.
+        template<typename V, typename SkipParser, typename Parser>
+        std::shared_ptr<search_prefilter const>
+        make_view_search_prefilter(Parser const & parser)
+        {
+            if constexpr (
+                std::is_same_v<range_value_t<V>, char> &&
+                std::is_same_v<SkipParser, eps_parser<phony>>) {
+                return std::make_shared<search_prefilter const>(
+                    detail::search_prefilter_for(parser.parser_));
+            } else {
+                return nullptr;
+            }
+        }
+
+        // The error handler used while search_impl() tries its parser at
+        // each place the prefilter finds.  An error there would be reported
+        // relative to the wrong range, and perhaps once per place, so it is
+        // only noted; search_impl() then does the whole search again without
+        // the prefilter, and that reports it.  Diagnostics from semantic
+        // actions are reported relative to the whole range.
+        template<typename Iter>
+        struct search_probe_error_handler
+        {
+            template<typename I, typename Sentinel, typename Error>
+            error_handler_result operator()(I, Sentinel, Error const &) const
+            {
+                failed_ = true;
+                return error_handler_result::fail;
+            }
+
+            template<typename Context, typename I>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context,
+                I it) const
+            {
+                auto input_context = context;
+                input_context.first_ = first_;
+                input_context.last_ = last_;
+                default_error_handler{}.diagnose(
+                    kind, message, input_context, it);
+            }
+
+            template<typename Context>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context) const
+            {
+                diagnose(
+                    kind, message, context, parser::_where(context).begin());
+            }
+
+            Iter first_;
+            Iter last_;
+            bool & failed_;
+        };
+
         template<
             typename R,
             typename Parser,
@@ -98,7 +511,8 @@ namespace boost::parser {
             R && r,
             parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
             parser_interface<SkipParser> const & skip,
-            trace trace_mode)
+            trace trace_mode,
+            search_prefilter const * prefilter = nullptr)
         {
             auto first = text::detail::begin(r);
             auto const last = text::detail::end(r);
@@ -106,6 +520,49 @@ namespace boost::parser {
             if (first == last)
                 return BOOST_PARSER_SUBRANGE(first, first);
 
+            if constexpr (use_search_prefilter_v<
+                              decltype(first),
+                              remove_cv_ref_t<decltype(last)>,
+                              SkipParser>) {
+                search_prefilter local_prefilter;
+                if (!prefilter) {
+                    local_prefilter =
+                        detail::search_prefilter_for(parser.parser_);
+                    prefilter = &local_prefilter;
+                }
+                if (prefilter->valid && trace_mode == trace::off) {
+                    // Only try to match where prefilter says a match can
+                    // begin.
+                    char const * const chars_first =
+                        detail::to_char_pointer(first);
+                    char const * const chars_last =
+                        chars_first + (last - first);
+                    using probe_t =
+                        search_probe_error_handler<decltype(first)>;
+                    bool failed = false;
+                    probe_t const probe{first, last, failed};
+                    parser_interface<omit_parser<Parser>, nope, probe_t const &>
+                        match_parser{
+                            omit_parser<Parser>{parser.parser_}, nope{}, probe};
+                    for (char const * it = chars_first;; ++it) {
+                        it = prefilter->find(it, chars_last);
+                        if (it == chars_last)
+                            break;
+                        auto const match_first = first + (it - chars_first);
+                        auto match_last = match_first;
+                        if (parser::prefix_parse(
+                                match_last, last, match_parser, trace_mode)) {
+                            return BOOST_PARSER_SUBRANGE(
+                                match_first, match_last);
+                        }
+                        if (failed)
+                            break;
+                    }
+                    if (!failed)
+                        return BOOST_PARSER_SUBRANGE(last, last);
+                }
+            }
+
             auto const search_parser = omit[*(char_ - parser)] >> -raw[parser];
             if constexpr (std::is_same_v<SkipParser, eps_parser<phony>>) {
                 auto result = parser::prefix_parse(
@@ -137,11 +594,15 @@ namespace boost::parser {
             R && r,
             parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
             parser_interface<SkipParser> const & skip,
-            trace trace_mode)
+            trace trace_mode,
+            search_prefilter const * prefilter = nullptr)
         {
             using value_type = range_value_t<decltype(r)>;
-            if constexpr (std::is_same_v<value_type, char>) {
-                return detail::search_impl((R &&) r, parser, skip, trace_mode);
+            if constexpr (
+                std::is_same_v<value_type, char> ||
+                is_decoded_utf32_v<remove_cv_ref_t<R>>) {
+                return detail::search_impl(
+                    (R &&) r, parser, skip, trace_mode, prefilter);
             } else {
                 auto r_unpacked = detail::text::unpack_iterator_and_sentinel(
                     text::detail::begin(r), text::detail::end(r));
@@ -313,7 +774,8 @@ namespace boost::parser {
             base_(std::move(base)),
             parser_(parser),
             skip_(skip),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
         constexpr search_all_view(
             V base,
@@ -322,7 +784,8 @@ namespace boost::parser {
             base_(std::move(base)),
             parser_(parser),
             skip_(),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
 
         constexpr V base() const &
@@ -381,8 +844,12 @@ namespace boost::parser {
             constexpr iterator & operator++()
             {
                 r_ = BOOST_PARSER_SUBRANGE<I, S>(next_it_, r_.end());
-                curr_ = parser::search(
-                    r_, parent_->parser_, parent_->skip_, parent_->trace_mode_);
+                curr_ = detail::search_repack_shim(
+                    r_,
+                    parent_->parser_,
+                    parent_->skip_,
+                    parent_->trace_mode_,
+                    parent_->prefilter_.get());
                 next_it_ = curr_.end();
                 if (curr_.begin() == curr_.end())
                     r_ = BOOST_PARSER_SUBRANGE<I, S>(next_it_, r_.end());
@@ -424,6 +891,7 @@ namespace boost::parser {
         parser_interface<Parser, GlobalState, ErrorHandler> parser_;
         parser_interface<SkipParser> skip_;
         trace trace_mode_;
+        std::shared_ptr<detail::search_prefilter const> prefilter_;
     };
 
     // deduction guides
@@ -32,7 +32,8 @@ namespace boost::parser {
             base_(std::move(base)),
             parser_(parser),
             skip_(skip),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
         constexpr split_view(
             V base,
@@ -41,7 +42,8 @@ namespace boost::parser {
             base_(std::move(base)),
             parser_(parser),
             skip_(),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
 
         constexpr V base() const &
@@ -106,8 +108,12 @@ namespace boost::parser {
                     return *this;
                 }
                 r_ = BOOST_PARSER_SUBRANGE<I, S>(next_it_, r_.end());
-                auto const curr_match = parser::search(
-                    r_, parent_->parser_, parent_->skip_, parent_->trace_mode_);
+                auto const curr_match = detail::search_repack_shim(
+                    r_,
+                    parent_->parser_,
+                    parent_->skip_,
+                    parent_->trace_mode_,
+                    parent_->prefilter_.get());
                 curr_ = BOOST_PARSER_SUBRANGE(next_it_, curr_match.begin());
                 next_it_ = curr_match.end();
                 next_follows_match_ = !curr_match.empty();
@@ -150,6 +156,7 @@ namespace boost::parser {
         parser_interface<Parser, GlobalState, ErrorHandler> parser_;
         parser_interface<SkipParser> skip_;
         trace trace_mode_;
+        std::shared_ptr<detail::search_prefilter const> prefilter_;
     };
 
     // deduction guides
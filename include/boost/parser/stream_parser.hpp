@@ -0,0 +1,303 @@
+#ifndef BOOST_PARSER_STREAM_PARSER_HPP
+#define BOOST_PARSER_STREAM_PARSER_HPP
+
+#include <boost/parser/parser.hpp>
+
+#include <string>
+#include <string_view>
+
+
+namespace boost::parser {
+
+    namespace detail {
+        // The end of the input buffered so far.  Comparing equal to it means
+        // that the parser tried to look past what has been received, and so
+        // might have parsed differently had more input been available.
+        template<typename CharType>
+        struct stream_sentinel
+        {
+            CharType const * last_ = nullptr;
+            bool * hit_end_ = nullptr;
+
+            friend bool operator==(CharType const * it, stream_sentinel s)
+            {
+                if (it != s.last_)
+                    return false;
+                *s.hit_end_ = true;
+                return true;
+            }
+            friend bool operator==(stream_sentinel s, CharType const * it)
+            {
+                return it == s;
+            }
+            friend bool operator!=(CharType const * it, stream_sentinel s)
+            {
+                return !(it == s);
+            }
+            friend bool operator!=(stream_sentinel s, CharType const * it)
+            {
+                return !(it == s);
+            }
+        };
+
+        // Passes errors and diagnostics on to error_handler_, except for
+        // ones issued after the parse has looked past the end of the input
+        // buffered so far.  Those may be due only to the missing input; the
+        // record is parsed again once more input arrives, and reported then
+        // if it still fails.
+        template<typename ErrorHandler>
+        struct stream_error_handler_adaptor
+        {
+            template<typename Iter, typename Sentinel, typename Error>
+            auto operator()(Iter first, Sentinel last, Error const & e) const
+                -> decltype(std::declval<ErrorHandler const &>()(
+                    first, last, e))
+            {
+                if (*hit_end_)
+                    return error_handler_result::fail;
+                *reported_ = true;
+                return (*error_handler_)(first, last, e);
+            }
+
+            template<typename Context, typename Iter>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context,
+                Iter it) const
+            {
+                if (!*hit_end_)
+                    error_handler_->diagnose(kind, message, context, it);
+            }
+
+            template<typename Context>
+            void diagnose(
+                diagnostic_kind kind,
+                std::string_view message,
+                Context const & context) const
+            {
+                if (!*hit_end_)
+                    error_handler_->diagnose(kind, message, context);
+            }
+
+            ErrorHandler const * error_handler_;
+            bool const * hit_end_;
+            bool * reported_;
+        };
+    }
+
+    /** Parses a sequence of records that arrives in chunks, such as data
+        read from a socket or a file in fixed-size blocks.
+
+        Each call to `feed()` appends a chunk to the input, and parses as
+        many complete records from the input as possible, using the record
+        parser (and the skipper, if any).  `handler` is called with the
+        attribute of each record, in order, as soon as the record is known to
+        be complete; if the record parser has no attribute, `handler` is
+        called with no arguments.  Only the input that has not yet been
+        parsed into records is kept between calls, so the memory used is
+        bounded by the size of the largest record, not of the whole input.
+
+        A record is complete once it has been parsed without looking past
+        the end of the input received so far.  A record that did look past
+        the end is parsed again when more input arrives (or when `finish()`
+        is called), and errors reported while parsing it are only passed to
+        the error handler once it is known that they are not due to missing
+        input.  Positions seen by the error handler and by semantic actions
+        are in a buffer that starts at the first unparsed record.
+
+        Once a record fails to parse, `feed()` and `finish()` only append
+        their input, and return `false`, until `discard()` is called to drop
+        the input that could not be parsed. */
+    template<
+        typename CharType,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser,
+        typename Handler>
+    struct stream_parser
+    {
+        using char_type = CharType;
+
+        stream_parser(
+            parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+            parser_interface<SkipParser> const & skip,
+            Handler handler) :
+            parser_(parser), skip_(skip), handler_(std::move(handler))
+        {}
+
+        /** Appends `[first, last)` to the input, then parses and hands to
+            the handler every complete record in the input.  Returns `false`
+            if a record failed to parse. */
+        bool feed(CharType const * first, CharType const * last)
+        {
+            buf_.erase(0, next_);
+            next_ = 0;
+            buf_.append(first, last);
+            return parse_records(false);
+        }
+
+        /** Appends `chunk` to the input, then parses and hands to the
+            handler every complete record in the input.  Returns `false` if a
+            record failed to parse. */
+        bool feed(std::basic_string_view<CharType> chunk)
+        {
+            return feed(chunk.data(), chunk.data() + chunk.size());
+        }
+
+        /** Indicates that there is no more input, and parses the records
+            that remain.  Returns `true` if all of the input was parsed into
+            records.  After a call to `finish()`, the `stream_parser` can be
+            fed a new sequence of records. */
+        bool finish() { return parse_records(true); }
+
+        /** Returns the input that has not yet been parsed into records. */
+        std::basic_string_view<CharType> unparsed() const
+        {
+            return std::basic_string_view<CharType>(buf_).substr(next_);
+        }
+
+        /** Drops the first `n` elements of `unparsed()`, for instance to
+            resume parsing after a malformed record, and clears the failed
+            state.  The remaining input is parsed on the next call to
+            `feed()` or `finish()`. */
+        void discard(std::size_t n)
+        {
+            next_ += (std::min)(n, buf_.size() - next_);
+            failed_ = false;
+        }
+
+        /** Returns `true` if a record failed to parse, and `discard()` has
+            not been called since. */
+        bool failed() const { return failed_; }
+
+    private:
+        template<typename Iter, typename Sentinel, typename P>
+        auto parse_record(Iter & first, Sentinel last, P const & p) const
+        {
+            if constexpr (detail::is_nope_v<SkipParser>)
+                return boost::parser::prefix_parse(first, last, p);
+            else
+                return boost::parser::prefix_parse(first, last, p, skip_);
+        }
+
+        bool parse_records(bool final)
+        {
+            if (failed_)
+                return false;
+
+            CharType const * const data = buf_.data();
+            CharType const * const last = data + buf_.size();
+            while (data + next_ != last) {
+                CharType const * const first = data + next_;
+                CharType const * it = first;
+                bool hit_end = false;
+                bool reported = false;
+                // Nothing is held back from the error handler once there is
+                // no more input to wait for.
+                bool const never = false;
+                detail::stream_sentinel<CharType> const sentinel{last, &hit_end};
+
+                if constexpr (!detail::is_nope_v<SkipParser>) {
+                    // Input that ends with skippable input is complete.
+                    if (final) {
+                        boost::parser::prefix_parse(
+                            it, sentinel, omit[*skip_]);
+                        if (it == last) {
+                            next_ = buf_.size();
+                            break;
+                        }
+                        it = first;
+                    }
+                }
+
+                using error_handler_type =
+                    detail::stream_error_handler_adaptor<
+                        detail::remove_cv_ref_t<ErrorHandler>>;
+                parser_interface<Parser, GlobalState, error_handler_type> const
+                    p{parser_.parser_,
+                      parser_.globals_,
+                      error_handler_type{
+                          &parser_.error_handler_,
+                          final ? &never : &hit_end,
+                          &reported}};
+                auto result = parse_record(it, sentinel, p);
+
+                if (!final && hit_end && !reported)
+                    return true;
+                if (!result || it == first) {
+                    failed_ = true;
+                    return false;
+                }
+
+                next_ = it - data;
+                if constexpr (std::is_same_v<decltype(result), bool>)
+                    handler_();
+                else
+                    handler_(std::move(*result));
+            }
+            if (final) {
+                buf_.clear();
+                next_ = 0;
+            }
+            return true;
+        }
+
+        parser_interface<Parser, GlobalState, ErrorHandler> parser_;
+        parser_interface<SkipParser> skip_;
+        Handler handler_;
+        std::basic_string<CharType> buf_;
+        std::size_t next_ = 0;
+        bool failed_ = false;
+    };
+
+    /** Returns a `stream_parser` that parses records of `CharType` with
+        `parser`, and calls `handler` with the attribute of each one. */
+    template<
+        typename CharType = char,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename Handler>
+    auto make_stream_parser(
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        Handler handler)
+    {
+        return stream_parser<
+            CharType,
+            Parser,
+            GlobalState,
+            ErrorHandler,
+            detail::nope,
+            Handler>(
+            parser, parser_interface<detail::nope>{}, std::move(handler));
+    }
+
+    /** Returns a `stream_parser` that parses records of `CharType` with
+        `parser`, skipping input matched by `skip` before and after each
+        record, and calls `handler` with the attribute of each one. */
+    template<
+        typename CharType = char,
+        typename Parser,
+        typename GlobalState,
+        typename ErrorHandler,
+        typename SkipParser,
+        typename Handler>
+    auto make_stream_parser(
+        parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
+        parser_interface<SkipParser> const & skip,
+        Handler handler)
+    {
+        return stream_parser<
+            CharType,
+            Parser,
+            GlobalState,
+            ErrorHandler,
+            SkipParser,
+            Handler>(parser, skip, std::move(handler));
+    }
+
+}
+
+#endif
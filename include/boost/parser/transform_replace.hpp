@@ -217,7 +217,8 @@ namespace boost::parser {
             R && r,
             parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
             parser_interface<SkipParser> const & skip,
-            trace trace_mode)
+            trace trace_mode,
+            search_prefilter const * prefilter = nullptr)
         {
             auto first = text::detail::begin(r);
             auto const last = text::detail::end(r);
@@ -231,9 +232,10 @@ namespace boost::parser {
                 match_last = _where(ctx).begin();
             };
 
+            auto const match_parser =
+                lexeme[eps[before] >> parser::skip[parser] >> eps[after]];
             auto const search_parser =
-                omit[*(char_ - parser)] >>
-                -lexeme[eps[before] >> parser::skip[parser] >> eps[after]];
+                omit[*(char_ - parser)] >> -match_parser;
 
             using parse_result_outer = decltype(parser::prefix_parse(
                 first, last, search_parser, trace_mode));
@@ -255,6 +257,44 @@ namespace boost::parser {
                     BOOST_PARSER_SUBRANGE(first, first), parse_result{});
             }
 
+            if constexpr (use_search_prefilter_v<
+                              decltype(first),
+                              remove_cv_ref_t<decltype(last)>,
+                              SkipParser>) {
+                search_prefilter local_prefilter;
+                if (!prefilter) {
+                    local_prefilter =
+                        detail::search_prefilter_for(parser.parser_);
+                    prefilter = &local_prefilter;
+                }
+                if (prefilter->valid && trace_mode == trace::off) {
+                    // See search_impl().
+                    char const * const chars_first =
+                        detail::to_char_pointer(first);
+                    char const * const chars_last =
+                        chars_first + (last - first);
+                    for (char const * it = chars_first;; ++it) {
+                        it = prefilter->find(it, chars_last);
+                        if (it == chars_last)
+                            break;
+                        auto candidate = first + (it - chars_first);
+                        parse_result attr;
+                        if (parser::prefix_parse(
+                                candidate,
+                                last,
+                                match_parser,
+                                attr,
+                                trace_mode)) {
+                            return return_tuple(
+                                BOOST_PARSER_SUBRANGE(match_first, match_last),
+                                std::move(attr));
+                        }
+                    }
+                    return return_tuple(
+                        BOOST_PARSER_SUBRANGE(last, last), parse_result{});
+                }
+            }
+
             if constexpr (std::is_same_v<SkipParser, eps_parser<phony>>) {
                 auto result = parser::prefix_parse(
                     first, last, search_parser, trace_mode);
@@ -287,12 +327,15 @@ namespace boost::parser {
             R && r,
             parser_interface<Parser, GlobalState, ErrorHandler> const & parser,
             parser_interface<SkipParser> const & skip,
-            trace trace_mode)
+            trace trace_mode,
+            search_prefilter const * prefilter = nullptr)
         {
             using value_type = range_value_t<decltype(r)>;
-            if constexpr (std::is_same_v<value_type, char>) {
+            if constexpr (
+                std::is_same_v<value_type, char> ||
+                is_decoded_utf32_v<remove_cv_ref_t<R>>) {
                 return detail::attr_search_impl(
-                    (R &&) r, parser, skip, trace_mode);
+                    (R &&) r, parser, skip, trace_mode, prefilter);
             } else {
                 auto r_unpacked = detail::text::unpack_iterator_and_sentinel(
                     text::detail::begin(r), text::detail::end(r));
@@ -363,7 +406,8 @@ namespace boost::parser {
             f_(std::move(f)),
             parser_(parser),
             skip_(skip),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
         constexpr transform_replace_view(
             V base,
@@ -374,7 +418,8 @@ namespace boost::parser {
             f_(std::move(f)),
             parser_(parser),
             skip_(),
-            trace_mode_(trace_mode)
+            trace_mode_(trace_mode),
+            prefilter_(detail::make_view_search_prefilter<V, SkipParser>(parser))
         {}
 
         constexpr V base() const &
@@ -447,7 +492,8 @@ namespace boost::parser {
                         r_,
                         parent_->parser_,
                         parent_->skip_,
-                        parent_->trace_mode_);
+                        parent_->trace_mode_,
+                        parent_->prefilter_.get());
                     auto const new_match =
                         parser::get(new_match_and_attr, llong<0>{});
                     parent_->f_(
@@ -515,6 +561,7 @@ namespace boost::parser {
         parser_interface<Parser, GlobalState, ErrorHandler> parser_;
         parser_interface<SkipParser> skip_;
         trace trace_mode_;
+        std::shared_ptr<detail::search_prefilter const> prefilter_;
     };
 
     // deduction guides
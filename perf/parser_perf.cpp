@@ -0,0 +1,977 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/parser/mapped_file.hpp>
+#include <boost/parser/parallel_parse.hpp>
+#include <boost/parser/parser.hpp>
+#include <boost/parser/replace.hpp>
+#include <boost/parser/search.hpp>
+#include <boost/parser/split.hpp>
+#include <boost/parser/stream_parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace bp = boost::parser;
+
+// Throughput of the parsers most grammars are built from, on generated
+// inputs shaped like the ones we actually parse: CSV records, log lines and
+// JSON-like nested lists.  Every benchmark reports bytes/second.
+
+namespace {
+    // A small LCG, so that the inputs are the same on every run and every
+    // platform.
+    struct lcg
+    {
+        unsigned int next()
+        {
+            x_ = x_ * 1103515245u + 12345u;
+            return (x_ >> 16) & 0x7fff;
+        }
+        unsigned int x_ = 42;
+    };
+
+    std::string const & int_list()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 20000; ++i) {
+                if (i)
+                    s += ',';
+                int const x = int(gen.next() * gen.next()) - (1 << 28);
+                s += std::to_string(x);
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    std::string const & uint_list()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 20000; ++i) {
+                if (i)
+                    s += ',';
+                s += std::to_string(gen.next() * gen.next());
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    std::string const & double_list()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 20000; ++i) {
+                if (i)
+                    s += ',';
+                s += std::to_string(gen.next() / 7.0);
+                if (i % 3 == 0)
+                    s += "e-" + std::to_string(gen.next() % 30);
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    std::string word(lcg & gen)
+    {
+        std::string retval(2 + gen.next() % 9, ' ');
+        for (auto & c : retval) {
+            c = char('a' + gen.next() % 26);
+        }
+        return retval;
+    }
+
+    char const * const levels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+    // Lines like "2024-03-07 12:34:56 [INFO] component: message key=value".
+    std::string const & log_lines()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 5000; ++i) {
+                s += "2024-03-0" + std::to_string(1 + gen.next() % 9) + " " +
+                     std::to_string(10 + gen.next() % 14) + ":" +
+                     std::to_string(10 + gen.next() % 50) + ":" +
+                     std::to_string(10 + gen.next() % 50) + " [" +
+                     levels[gen.next() % 4] + "] " + word(gen) + ": ";
+                for (int j = 0, n = 3 + gen.next() % 8; j < n; ++j) {
+                    s += word(gen) + ' ';
+                }
+                s += word(gen) + '=' + std::to_string(gen.next()) + '\n';
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    // Records like "17,name,3.25,true".
+    std::string const & csv_lines()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 10000; ++i) {
+                s += std::to_string(i) + ',' + word(gen) + ',' +
+                     std::to_string(gen.next() / 13.0) + ',' +
+                     (gen.next() % 2 ? "true" : "false") + '\n';
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    // Nested lists like "[1,[2,3],[[4]],5]".
+    void nested_list(lcg & gen, int depth, std::string & s)
+    {
+        s += '[';
+        for (int i = 0, n = 1 + gen.next() % 4; i < n; ++i) {
+            if (i)
+                s += ',';
+            if (depth < 6 && gen.next() % 3 == 0)
+                nested_list(gen, depth + 1, s);
+            else
+                s += std::to_string(gen.next());
+        }
+        s += ']';
+    }
+    std::string const & nested_lists()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s = "[";
+            for (int i = 0; i < 2000; ++i) {
+                if (i)
+                    s += ',';
+                nested_list(gen, 0, s);
+            }
+            s += ']';
+            return s;
+        }();
+        return retval;
+    }
+
+    // The same lists, pretty-printed, with each element on its own line,
+    // indented four spaces per level.
+    std::string const & indented_lists()
+    {
+        static std::string const retval = [] {
+            std::string s;
+            int depth = 0;
+            for (char c : nested_lists()) {
+                if (c == ']') {
+                    --depth;
+                    s += '\n' + std::string(4 * depth, ' ');
+                }
+                s += c;
+                if (c == '[')
+                    ++depth;
+                if (c == '[' || c == ',')
+                    s += '\n' + std::string(4 * depth, ' ');
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    void set_bytes(benchmark::State & state, std::string const & input)
+    {
+        state.SetBytesProcessed(
+            int64_t(state.iterations()) * int64_t(input.size()));
+    }
+
+    template<typename Parser>
+    void run_parse(
+        benchmark::State & state, std::string const & input, Parser const & p)
+    {
+        while (state.KeepRunning()) {
+            auto result = bp::parse(input, p);
+            benchmark::DoNotOptimize(result);
+            if (!result) {
+                state.SkipWithError("parse failed");
+                break;
+            }
+        }
+        set_bytes(state, input);
+    }
+
+    template<typename Parser, typename Skipper>
+    void run_parse(
+        benchmark::State & state,
+        std::string const & input,
+        Parser const & p,
+        Skipper const & skip)
+    {
+        while (state.KeepRunning()) {
+            auto result = bp::parse(input, p, skip);
+            benchmark::DoNotOptimize(result);
+            if (!result) {
+                state.SkipWithError("parse failed");
+                break;
+            }
+        }
+        set_bytes(state, input);
+    }
+}
+
+// Numbers.
+
+void BM_int_list(benchmark::State & state)
+{
+    run_parse(state, int_list(), bp::int_ % ',');
+}
+BENCHMARK(BM_int_list);
+
+void BM_uint_list(benchmark::State & state)
+{
+    run_parse(state, uint_list(), bp::uint_ % ',');
+}
+BENCHMARK(BM_uint_list);
+
+void BM_double_list(benchmark::State & state)
+{
+    run_parse(state, double_list(), bp::double_ % ',');
+}
+BENCHMARK(BM_double_list);
+
+void BM_precise_double_list(benchmark::State & state)
+{
+    run_parse(state, double_list(), bp::precise_double_ % ',');
+}
+BENCHMARK(BM_precise_double_list);
+
+void BM_double_list_utf32(benchmark::State & state)
+{
+    std::string const & input = double_list();
+    while (state.KeepRunning()) {
+        auto result = bp::parse(input | bp::as_utf32, bp::double_ % ',');
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_double_list_utf32);
+
+void BM_precise_double_list_utf32(benchmark::State & state)
+{
+    std::string const & input = double_list();
+    while (state.KeepRunning()) {
+        auto result =
+            bp::parse(input | bp::as_utf32, bp::precise_double_ % ',');
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_precise_double_list_utf32);
+
+// JSON numbers, as example/json.cpp used to parse them (matching the JSON
+// syntax with raw[], then parsing the match again with double_), and with
+// json_number.
+namespace {
+    auto const to_double = [](auto & ctx) {
+        auto first = _attr(ctx).begin();
+        _val(ctx) = *bp::prefix_parse(first, _attr(ctx).end(), bp::double_);
+    };
+    bp::rule<struct json_number_tag, double> const json_number_reparse =
+        "json_number_reparse";
+    auto const json_number_reparse_def =
+        bp::raw[bp::lexeme
+                    [-bp::char_('-') >>
+                     (bp::char_('1', '9') >> *bp::digit | bp::char_('0')) >>
+                     -(bp::char_('.') >> +bp::digit) >>
+                     -(bp::char_("eE") >> -bp::char_("+-") >> +bp::digit)]]
+               [to_double];
+    BOOST_PARSER_DEFINE_RULES(json_number_reparse);
+}
+
+void BM_json_number_list_reparse(benchmark::State & state)
+{
+    std::string const & input = double_list();
+    while (state.KeepRunning()) {
+        auto result = bp::parse(input | bp::as_utf32, json_number_reparse % ',');
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_json_number_list_reparse);
+
+void BM_json_number_list(benchmark::State & state)
+{
+    std::string const & input = double_list();
+    while (state.KeepRunning()) {
+        auto result = bp::parse(input | bp::as_utf32, bp::json_number % ',');
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_json_number_list);
+
+// Characters, strings and repetition.
+
+void BM_char_set_words(benchmark::State & state)
+{
+    auto const ident = +bp::char_(
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ=0123456789");
+    run_parse(state, log_lines(), *(ident | bp::omit[+bp::char_(" :[]-\n")]));
+}
+BENCHMARK(BM_char_set_words);
+
+void BM_char_set_words_no_case(benchmark::State & state)
+{
+    auto const ident =
+        +bp::char_("abcdefghijklmnopqrstuvwxyz=0123456789");
+    run_parse(
+        state,
+        log_lines(),
+        bp::no_case[*(ident | bp::omit[+bp::char_(" :[]-\n")])]);
+}
+BENCHMARK(BM_char_set_words_no_case);
+
+void BM_char_classes(benchmark::State & state)
+{
+    auto const other = bp::char_ - bp::lower - bp::upper - bp::punct;
+    run_parse(
+        state,
+        log_lines(),
+        *(+bp::lower | +bp::upper | +bp::punct | bp::omit[+other]));
+}
+BENCHMARK(BM_char_classes);
+
+void BM_char_ranges_plus(benchmark::State & state)
+{
+    auto const ident =
+        +(bp::char_('a', 'z') | bp::char_('A', 'Z') | bp::char_('0', '9') |
+          bp::char_('='));
+    run_parse(state, log_lines(), *(ident | bp::omit[+bp::char_(" :[]-\n")]));
+}
+BENCHMARK(BM_char_ranges_plus);
+
+void BM_string_repeat(benchmark::State & state)
+{
+    std::string input;
+    for (int i = 0; i < 10000; ++i) {
+        input += "GET /index.html ";
+    }
+    run_parse(state, input, *bp::string("GET /index.html "));
+}
+BENCHMARK(BM_string_repeat);
+
+void BM_case_sensitive_tokens(benchmark::State & state)
+{
+    // A tokenizer with no no_case[] in it, so every comparison is exact.
+    auto const keyword = bp::string("DEBUG") | bp::string("INFO") |
+                         bp::string("WARN") | bp::string("ERROR");
+    auto const ident = +bp::char_('a', 'z');
+    auto const number = +bp::char_('0', '9');
+    auto const punct = bp::char_(" :[]-=\n");
+    run_parse(
+        state, log_lines(), *bp::omit[keyword | ident | number | punct]);
+}
+BENCHMARK(BM_case_sensitive_tokens);
+
+void BM_json_keywords(benchmark::State & state)
+{
+    std::string input;
+    for (int i = 0; i < 10000; ++i) {
+        input += "true,false,null,";
+    }
+    auto const keyword =
+        bp::string("true") | bp::string("false") | bp::string("null");
+    run_parse(state, input, *bp::omit[keyword >> ',']);
+}
+BENCHMARK(BM_json_keywords);
+
+// Log lines: alternatives, symbols and no_case.
+
+namespace {
+    template<typename LevelParser>
+    auto log_line(LevelParser level)
+    {
+        auto const date = bp::uint_ >> '-' >> bp::uint_ >> '-' >> bp::uint_;
+        auto const time = bp::uint_ >> ':' >> bp::uint_ >> ':' >> bp::uint_;
+        auto const component = +(bp::char_ - ':');
+        auto const message = *(bp::char_ - bp::eol);
+        return date >> ' ' >> time >> " [" >> level >> "] " >> component >>
+               ": " >> message >> bp::eol;
+    }
+
+    bp::symbols<int> const level_symbols = {
+        {"DEBUG", 0}, {"INFO", 1}, {"WARN", 2}, {"ERROR", 3}};
+}
+
+void BM_log_alternatives(benchmark::State & state)
+{
+    auto const level = bp::string("DEBUG") | bp::string("INFO") |
+                       bp::string("WARN") | bp::string("ERROR");
+    run_parse(state, log_lines(), *log_line(level));
+}
+BENCHMARK(BM_log_alternatives);
+
+void BM_log_symbols(benchmark::State & state)
+{
+    run_parse(state, log_lines(), *log_line(level_symbols));
+}
+BENCHMARK(BM_log_symbols);
+
+void BM_log_no_case(benchmark::State & state)
+{
+    auto const level =
+        bp::no_case
+            [bp::string("debug") | bp::string("info") | bp::string("warn") |
+             bp::string("error")];
+    run_parse(state, log_lines(), *log_line(level));
+}
+BENCHMARK(BM_log_no_case);
+
+void BM_log_symbols_no_case(benchmark::State & state)
+{
+    run_parse(state, log_lines(), *log_line(bp::no_case[level_symbols]));
+}
+BENCHMARK(BM_log_symbols_no_case);
+
+namespace {
+    char const * const header_names[] = {
+        "Content-Type",
+        "Content-Length",
+        "Accept-Encoding",
+        "Cache-Control",
+        "Access-Control-Allow-Credentials",
+        "Host"};
+
+    // Lines like "content-TYPE: text/plain", with randomly cased names.
+    std::string const & http_headers()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 20000; ++i) {
+                std::string name = header_names[gen.next() % 6];
+                for (auto & c : name) {
+                    if (std::isalpha((unsigned char)c) && gen.next() % 2)
+                        c ^= 0x20;
+                }
+                s += name + ": " + word(gen) + "\r\n";
+            }
+            return s;
+        }();
+        return retval;
+    }
+}
+
+void BM_http_headers_no_case(benchmark::State & state)
+{
+    auto const name =
+        bp::no_case
+            [bp::string("content-type") | bp::string("content-length") |
+             bp::string("accept-encoding") | bp::string("cache-control") |
+             bp::string("access-control-allow-credentials") |
+             bp::string("host")];
+    auto const header = bp::omit[name] >> ": " >>
+                        bp::omit[*(bp::char_ - '\r')] >> "\r\n";
+    run_parse(state, http_headers(), bp::omit[*header]);
+}
+BENCHMARK(BM_http_headers_no_case);
+
+// JSON-like scalars: alternatives that can be told apart by their first
+// char.
+
+namespace {
+    // Values like "null", "true", "-12.5" and "\"word\"", separated by
+    // commas.
+    std::string const & scalars()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 20000; ++i) {
+                if (i)
+                    s += ',';
+                switch (gen.next() % 5) {
+                case 0: s += "null"; break;
+                case 1: s += gen.next() % 2 ? "true" : "false"; break;
+                case 2: s += std::to_string(int(gen.next()) - 16384); break;
+                case 3: s += std::to_string(gen.next() / -7.0); break;
+                default: s += '"' + word(gen) + '"'; break;
+                }
+            }
+            return s;
+        }();
+        return retval;
+    }
+}
+
+void BM_scalar_alternatives(benchmark::State & state)
+{
+    auto const quoted = '"' >> *(bp::char_ - '"') >> '"';
+    auto const scalar = bp::lit("null") | bp::bool_ | bp::double_ | quoted;
+    run_parse(state, scalars(), scalar % ',');
+}
+BENCHMARK(BM_scalar_alternatives);
+
+// CSV records, both attribute-producing and callback-driven.
+
+namespace {
+    struct csv_record_tag
+    {};
+    bp::callback_rule<csv_record_tag, bp::tuple<int, std::string, double, bool>>
+        csv_record = "csv_record";
+    auto const csv_record_def = bp::int_ >> ',' >> +(bp::char_ - ',') >> ',' >>
+                                bp::double_ >> ',' >> bp::bool_ >> bp::eol;
+    BOOST_PARSER_DEFINE_RULES(csv_record);
+
+    struct csv_callbacks
+    {
+        void operator()(
+            csv_record_tag,
+            bp::tuple<int, std::string, double, bool> && record) const
+        {
+            benchmark::DoNotOptimize(record);
+            ++count;
+        }
+        mutable std::size_t count = 0;
+    };
+}
+
+void BM_csv_attributes(benchmark::State & state)
+{
+    run_parse(state, csv_lines(), *csv_record);
+}
+BENCHMARK(BM_csv_attributes);
+
+void BM_csv_callbacks(benchmark::State & state)
+{
+    std::string const & input = csv_lines();
+    csv_callbacks callbacks;
+    while (state.KeepRunning()) {
+        bool const result = bp::callback_parse(input, *csv_record, callbacks);
+        benchmark::DoNotOptimize(result);
+        if (!result) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_csv_callbacks);
+
+// The same records, fed to a stream_parser in 64 KiB chunks.
+void BM_csv_stream(benchmark::State & state)
+{
+    std::string const & input = csv_lines();
+    std::size_t const chunk_size = 1 << 16;
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        auto sp = bp::make_stream_parser(
+            csv_record, [&](bp::tuple<int, std::string, double, bool> && r) {
+                benchmark::DoNotOptimize(r);
+                ++count;
+            });
+        bool result = true;
+        for (std::size_t i = 0; result && i < input.size(); i += chunk_size) {
+            result = sp.feed(std::string_view(input).substr(i, chunk_size));
+        }
+        if (!result || !sp.finish()) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_csv_stream);
+
+void BM_csv_parallel(benchmark::State & state)
+{
+    std::string const & input = csv_lines();
+    while (state.KeepRunning()) {
+        auto result = bp::parallel_parse(input, '\n', *csv_record);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_csv_parallel);
+
+void BM_csv_fields(benchmark::State & state)
+{
+    auto const field = *(bp::char_ - ',' - bp::eol);
+    run_parse(state, csv_lines(), *((field % ',') >> bp::eol));
+}
+BENCHMARK(BM_csv_fields);
+
+void BM_csv_fields_views(benchmark::State & state)
+{
+    auto const field = *(bp::char_ - ',' - bp::eol);
+    run_parse(state, csv_lines(), bp::views[*((field % ',') >> bp::eol)]);
+}
+BENCHMARK(BM_csv_fields_views);
+
+// UTF-8 input.
+
+namespace {
+    // JSON objects like {"name": "abc", "count": 17}, where about one
+    // string value in eight has a non-ASCII code point in it.
+    std::string const & utf8_objects()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s = "[";
+            for (int i = 0; i < 5000; ++i) {
+                if (i)
+                    s += ", ";
+                s += "{\"name\": \"" + word(gen);
+                if (gen.next() % 8 == 0)
+                    s += "\xc3\xb4" + word(gen);
+                s += "\", \"count\": " + std::to_string(gen.next()) + "}";
+            }
+            s += ']';
+            return s;
+        }();
+        return retval;
+    }
+
+    auto const utf8_string = bp::lexeme['"' >> *(bp::cp - '"') >> '"'];
+    auto const utf8_member = utf8_string >> ':' >> (bp::uint_ | utf8_string);
+    auto const utf8_object = '{' >> (utf8_member % ',') >> '}';
+    auto const utf8_array = '[' >> bp::omit[utf8_object % ','] >> ']';
+}
+
+void BM_utf8_objects(benchmark::State & state)
+{
+    std::string const & input = utf8_objects();
+    while (state.KeepRunning()) {
+        auto result = bp::parse(input | bp::as_utf32, utf8_array, bp::ws);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_utf8_objects);
+
+void BM_utf8_objects_decoded(benchmark::State & state)
+{
+    std::string const & input = utf8_objects();
+    while (state.KeepRunning()) {
+        bp::decoded_utf32 const decoded(input);
+        auto result = bp::parse(decoded, utf8_array, bp::ws);
+        benchmark::DoNotOptimize(result);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_utf8_objects_decoded);
+
+// Recursive rules, with a skipper.
+
+namespace {
+    bp::rule<struct list_tag> const list = "list";
+    auto const list_def = '[' >> ((bp::uint_ | list) % ',') >> ']';
+    BOOST_PARSER_DEFINE_RULES(list);
+}
+
+void BM_rule_recursion(benchmark::State & state)
+{
+    run_parse(state, nested_lists(), list, bp::ws);
+}
+BENCHMARK(BM_rule_recursion);
+
+void BM_rule_recursion_indented(benchmark::State & state)
+{
+    run_parse(state, indented_lists(), list, bp::ws);
+}
+BENCHMARK(BM_rule_recursion_indented);
+
+// Alternatives that share a long prefix, with and without memoization.
+
+namespace {
+    // Expressions like ((((1*2)-3)*4)-5)+6, nested eight deep.  Each
+    // level tries operand once for each alternative of sum that fails, so
+    // without memoization the work grows exponentially with the depth.
+    std::string const & nested_sums()
+    {
+        static std::string const retval = [] {
+            lcg gen;
+            std::string s;
+            for (int i = 0; i < 200; ++i) {
+                if (i)
+                    s += ',';
+                std::string sum = std::to_string(gen.next());
+                for (int j = 0; j < 8; ++j) {
+                    sum = "(" + sum + (gen.next() % 2 ? "*" : "-") +
+                          std::to_string(gen.next()) + ")";
+                }
+                s += sum + "+1";
+            }
+            return s;
+        }();
+        return retval;
+    }
+
+    bp::rule<struct sum_tag> const sum = "sum";
+    bp::rule<struct operand_tag> const operand = "operand";
+    auto const sum_def = operand >> '+' >> operand |
+                         operand >> '-' >> operand |
+                         operand >> '*' >> operand | operand;
+    auto const operand_def = bp::uint_ | '(' >> sum >> ')';
+    BOOST_PARSER_DEFINE_RULES(sum, operand);
+
+    bp::rule<struct memo_sum_tag> const memo_sum = "memo_sum";
+    bp::rule<struct memo_operand_tag> const memo_operand = "memo_operand";
+    auto const memo_sum_def = memo_operand >> '+' >> memo_operand |
+                              memo_operand >> '-' >> memo_operand |
+                              memo_operand >> '*' >> memo_operand |
+                              memo_operand;
+    auto const memo_operand_def =
+        bp::memoize[bp::uint_ | '(' >> memo_sum >> ')'];
+    BOOST_PARSER_DEFINE_RULES(memo_sum, memo_operand);
+}
+
+void BM_backtracking(benchmark::State & state)
+{
+    run_parse(state, nested_sums(), sum % ',');
+}
+BENCHMARK(BM_backtracking);
+
+void BM_backtracking_memoized(benchmark::State & state)
+{
+    run_parse(state, nested_sums(), memo_sum % ',');
+}
+BENCHMARK(BM_backtracking_memoized);
+
+// Expectation failures, on input in which some records are malformed.
+
+namespace {
+    // The records from csv_lines(), one per element, about 8% of which have
+    // had a char replaced so that they no longer parse.
+    std::vector<std::string> const & malformed_records()
+    {
+        static std::vector<std::string> const retval = [] {
+            lcg gen;
+            std::vector<std::string> records;
+            std::string const & lines = csv_lines();
+            std::size_t first = 0;
+            while (first != lines.size()) {
+                std::size_t const last = lines.find('\n', first);
+                std::string record = lines.substr(first, last - first);
+                if (gen.next() % 12 == 0)
+                    record[gen.next() % record.size()] = '#';
+                records.push_back(std::move(record));
+                first = last + 1;
+            }
+            return records;
+        }();
+        return retval;
+    }
+
+    // Counts errors, without printing them.
+    struct counting_error_handler : bp::default_error_handler
+    {
+        template<typename Iter, typename Sentinel>
+        bp::error_handler_result
+        operator()(Iter, Sentinel, bp::parse_error<Iter> const &) const
+        {
+            ++errors;
+            return bp::error_handler_result::fail;
+        }
+        mutable std::size_t errors = 0;
+    };
+
+    // The same, but the expectation failures are passed to it without
+    // throwing.
+    struct counting_status_error_handler : counting_error_handler
+    {
+        using counting_error_handler::operator();
+        template<typename Iter, typename Sentinel>
+        bp::error_handler_result
+        operator()(Iter, Sentinel, bp::expectation_failure<Iter> const &) const
+        {
+            ++errors;
+            return bp::error_handler_result::fail;
+        }
+    };
+
+    template<typename ErrorHandler>
+    void run_malformed_records(benchmark::State & state)
+    {
+        auto const record = bp::int_ > ',' > +(bp::char_ - ',') > ',' >
+                            bp::double_ > ',' > bp::bool_;
+        std::vector<std::string> const & records = malformed_records();
+        ErrorHandler error_handler;
+        auto const parser = bp::with_error_handler(record, error_handler);
+        std::size_t bytes = 0;
+        while (state.KeepRunning()) {
+            for (auto const & r : records) {
+                auto result = bp::parse(r, parser);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        for (auto const & r : records) {
+            bytes += r.size();
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(bytes));
+    }
+}
+
+void BM_malformed_records_throw(benchmark::State & state)
+{
+    run_malformed_records<counting_error_handler>(state);
+}
+BENCHMARK(BM_malformed_records_throw);
+
+void BM_malformed_records_status(benchmark::State & state)
+{
+    run_malformed_records<counting_status_error_handler>(state);
+}
+BENCHMARK(BM_malformed_records_status);
+
+// Warnings reported with a callback_error_handler, one per ten records.
+// Each diagnostic includes the line number of the record it is about.
+
+void BM_csv_warnings(benchmark::State & state)
+{
+    std::string const & input = csv_lines();
+    auto const warn = [](auto & ctx) {
+        if (_attr(ctx) % 10 == 0)
+            _report_warning(ctx, "round number", _where(ctx).begin());
+    };
+    auto const record = bp::omit[bp::int_[warn] >> *(bp::char_ - '\n')] >>
+                        '\n';
+    std::size_t warnings = 0;
+    bp::callback_error_handler const error_handler(
+        {}, [&warnings](std::string const &) { ++warnings; });
+    auto const parser = bp::with_error_handler(*record, error_handler);
+    while (state.KeepRunning()) {
+        bool const result = bp::parse(input, parser);
+        benchmark::DoNotOptimize(result);
+        if (!result) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+    }
+    benchmark::DoNotOptimize(warnings);
+    state.SetBytesProcessed(
+        int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_csv_warnings);
+
+// search(), split() and replace().
+
+void BM_search_all(benchmark::State & state)
+{
+    std::string const & input = log_lines();
+    while (state.KeepRunning()) {
+        int count = 0;
+        for (auto subrange :
+             input | bp::search_all(bp::lit("ERROR") >> ']')) {
+            benchmark::DoNotOptimize(subrange);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_search_all);
+
+void BM_split(benchmark::State & state)
+{
+    std::string const & input = csv_lines();
+    while (state.KeepRunning()) {
+        int count = 0;
+        for (auto subrange : input | bp::split(bp::char_(",\n"))) {
+            benchmark::DoNotOptimize(subrange);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_split);
+
+#if !defined(_MSC_VER) || BOOST_PARSER_USE_CONCEPTS
+void BM_replace(benchmark::State & state)
+{
+    std::string const & input = log_lines();
+    while (state.KeepRunning()) {
+        std::size_t size = 0;
+        for (auto subrange : input | bp::replace(bp::lit("WARN"), "W")) {
+            size += std::distance(subrange.begin(), subrange.end());
+        }
+        benchmark::DoNotOptimize(size);
+    }
+    set_bytes(state, input);
+}
+BENCHMARK(BM_replace);
+#endif
+
+// Scanning a file: reading it into a string first, vs. mapping it.
+
+namespace {
+    // log_lines(), repeated to about 16MB, in a temporary file.
+    std::string const & log_file()
+    {
+        static std::string const retval = [] {
+            std::string const path = "parser_perf_log_file.txt";
+            std::ofstream ofs(path, std::ios_base::binary);
+            for (std::size_t size = 0; size < (std::size_t(1) << 24);
+                 size += log_lines().size()) {
+                ofs << log_lines();
+            }
+            std::atexit([] { std::remove("parser_perf_log_file.txt"); });
+            return path;
+        }();
+        return retval;
+    }
+
+    template<typename R>
+    int count_errors(R const & r)
+    {
+        int count = 0;
+        for (auto subrange : r | bp::search_all(bp::lit("ERROR") >> ']')) {
+            benchmark::DoNotOptimize(subrange);
+            ++count;
+        }
+        return count;
+    }
+}
+
+void BM_search_all_file_read(benchmark::State & state)
+{
+    std::size_t size = 0;
+    while (state.KeepRunning()) {
+        std::ifstream ifs(log_file(), std::ios_base::binary);
+        std::ostringstream oss;
+        oss << ifs.rdbuf();
+        std::string const input = oss.str();
+        benchmark::DoNotOptimize(count_errors(input));
+        size = input.size();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+BENCHMARK(BM_search_all_file_read);
+
+void BM_search_all_file_mapped(benchmark::State & state)
+{
+    std::size_t size = 0;
+    while (state.KeepRunning()) {
+        bp::mapped_file const input(log_file());
+        benchmark::DoNotOptimize(count_errors(input));
+        size = input.size();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+BENCHMARK(BM_search_all_file_mapped);
+
+BENCHMARK_MAIN()
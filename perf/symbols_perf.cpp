@@ -0,0 +1,72 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/parser/parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+
+namespace bp = boost::parser;
+
+// Keys are "k0", "k1", ..., and are kept alive here, since symbols<T> stores
+// std::string_views.
+std::vector<std::string> make_keys(int n)
+{
+    std::vector<std::string> retval;
+    retval.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        retval.push_back("k" + std::to_string(i * 7919 % n));
+    }
+    return retval;
+}
+
+std::vector<std::string> const keys = make_keys(20000);
+
+// Filled in main().  Copies of a symbols<T> refer back to the original, so
+// this is not built by a function returning it by value.
+bp::symbols<int> table;
+
+// Many short, independent parses against one large table; this is dominated
+// by per-parse setup cost when the table is not shared between parses.
+void BM_symbols_small_parses(benchmark::State & state)
+{
+    std::size_t bytes = 0;
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        std::string const & key = keys[i++ % keys.size()];
+        benchmark::DoNotOptimize(bp::parse(key, table));
+        bytes += key.size();
+    }
+    state.SetBytesProcessed(int64_t(bytes));
+}
+BENCHMARK(BM_symbols_small_parses);
+
+// Same as above, but each parse mutates its copy of the table first.
+void BM_symbols_small_parses_mutating(benchmark::State & state)
+{
+    auto const erase_k0 = [](auto & ctx) { table.erase(ctx, "k0"); };
+    auto const parser = bp::eps[erase_k0] >> table;
+    std::size_t bytes = 0;
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        std::string const & key = keys[i++ % keys.size()];
+        benchmark::DoNotOptimize(bp::parse(key, parser));
+        bytes += key.size();
+    }
+    state.SetBytesProcessed(int64_t(bytes));
+}
+BENCHMARK(BM_symbols_small_parses_mutating);
+
+int main(int argc, char ** argv)
+{
+    for (int i = 0, end = (int)keys.size(); i < end; ++i) {
+        table.insert_for_next_parse(keys[i], i);
+    }
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+}
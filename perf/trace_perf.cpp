@@ -0,0 +1,94 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/parser/parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+
+namespace bp = boost::parser;
+
+// A validating JSON grammar with no attributes.  Every primitive below goes
+// through detail::scoped_trace() on each call, which makes this a good
+// measure of what tracing costs when it is turned off.
+namespace json {
+    bp::rule<struct value_tag> const value = "value";
+    bp::rule<struct string_tag> const string = "string";
+    bp::rule<struct array_tag> const array = "array";
+    bp::rule<struct object_tag> const object = "object";
+
+    auto const escape = bp::lit('\\') >> bp::char_("\"\\/bfnrt");
+    auto const string_def =
+        bp::lexeme['"' >> *(escape | (bp::char_ - '"' - '\\')) >> '"'];
+    auto const array_def = '[' >> -(value % ',') >> ']';
+    auto const object_def = '{' >> -((string >> ':' >> value) % ',') >> '}';
+    auto const value_def = bp::double_ | string | array | object |
+                           bp::lit("true") | bp::lit("false") |
+                           bp::lit("null");
+
+    BOOST_PARSER_DEFINE_RULES(value, string, array, object);
+}
+
+// Roughly the size and shape of the inputs used with example/json.cpp.
+std::string make_json(int records)
+{
+    std::string retval = "[\n";
+    for (int i = 0; i < records; ++i) {
+        if (i)
+            retval += ",\n";
+        retval += "  {\"id\": " + std::to_string(i) +
+                  ", \"name\": \"record \\\"" + std::to_string(i) +
+                  "\\\"\", \"score\": " + std::to_string(i * 0.37) +
+                  ", \"tags\": [\"a\", \"b\", \"c\"], \"active\": " +
+                  (i % 2 ? "true" : "false") + ", \"parent\": null}";
+    }
+    retval += "\n]\n";
+    return retval;
+}
+
+std::string const json_input = make_json(2000);
+
+void BM_json_trace_off(benchmark::State & state)
+{
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+            bp::parse(json_input, json::value, bp::ws, bp::trace::off));
+    }
+    state.SetBytesProcessed(
+        int64_t(state.iterations()) * int64_t(json_input.size()));
+}
+BENCHMARK(BM_json_trace_off);
+
+struct null_buf : std::streambuf
+{
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(char const *, std::streamsize n) override
+    {
+        return n;
+    }
+};
+
+// For comparison; the trace output is discarded, so this measures the cost
+// of producing it.
+void BM_json_trace_on(benchmark::State & state)
+{
+    null_buf buf;
+    auto const prev = std::cout.rdbuf(&buf);
+    std::string const input = make_json(20);
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+            bp::parse(input, json::value, bp::ws, bp::trace::on));
+    }
+    std::cout.rdbuf(prev);
+    state.SetBytesProcessed(
+        int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_json_trace_on);
+
+BENCHMARK_MAIN()
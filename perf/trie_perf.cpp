@@ -0,0 +1,90 @@
+// Copyright (C) 2024 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/parser/parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace bp = boost::parser;
+namespace detail = boost::parser::detail;
+
+using node_trie_t = detail::text::trie<std::vector<char32_t>, int>;
+
+// Pseudo-random lowercase words of 3-12 letters, like a keyword, unit or
+// currency table.
+struct table
+{
+    explicit table(int n)
+    {
+        unsigned int x = 12345;
+        auto next = [&x] {
+            x = x * 1103515245u + 12345u;
+            return (x >> 16) & 0x7fff;
+        };
+        for (int i = 0; i < n; ++i) {
+            std::string key(3 + next() % 10, ' ');
+            for (auto & c : key) {
+                c = char('a' + next() % 26);
+            }
+            keys.push_back(std::move(key));
+        }
+        for (int i = 0; i < n; ++i) {
+            elements.emplace_back(keys[i], i);
+            node_trie.insert(keys[i] | detail::text::as_utf32, i);
+        }
+        flat_trie = detail::flat_trie<int>(elements);
+    }
+
+    std::vector<std::string> keys;
+    std::vector<std::pair<std::string_view, int>> elements;
+    node_trie_t node_trie;
+    detail::flat_trie<int> flat_trie;
+};
+
+table const & get_table(int n)
+{
+    static std::map<int, table> tables;
+    auto it = tables.find(n);
+    if (it == tables.end())
+        it = tables.emplace(n, table(n)).first;
+    return it->second;
+}
+
+void BM_node_trie_longest_match(benchmark::State & state)
+{
+    table const & t = get_table(state.range(0));
+    std::size_t bytes = 0;
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        std::string const & key = t.keys[i++ % t.keys.size()];
+        auto const match = t.node_trie.longest_match(key.begin(), key.end());
+        benchmark::DoNotOptimize(match);
+        bytes += key.size();
+    }
+    state.SetBytesProcessed(int64_t(bytes));
+}
+BENCHMARK(BM_node_trie_longest_match)->Arg(1000)->Arg(100000);
+
+void BM_flat_trie_longest_match(benchmark::State & state)
+{
+    table const & t = get_table(state.range(0));
+    std::size_t bytes = 0;
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        std::string const & key = t.keys[i++ % t.keys.size()];
+        auto const match = t.flat_trie.longest_match(key.begin(), key.end());
+        benchmark::DoNotOptimize(match);
+        bytes += key.size();
+    }
+    state.SetBytesProcessed(int64_t(bytes));
+}
+BENCHMARK(BM_flat_trie_longest_match)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,137 @@
+/**
+ *   Copyright (C) 2024 T. Zachary Laine
+ *
+ *   Distributed under the Boost Software License, Version 1.0. (See
+ *   accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/parser/parser.hpp>
+#include <boost/parser/transcode_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+
+
+namespace bp = boost::parser;
+
+namespace {
+    template<typename Iter, typename Sentinel>
+    void check_all_positions(Iter first, Sentinel last)
+    {
+        bp::line_index<Iter> const index(first, last);
+        for (Iter it = first;; ++it) {
+            auto const expected = bp::find_line_position(first, it);
+            auto const position = index.position(it);
+            EXPECT_TRUE(position.line_start == expected.line_start)
+                << "offset=" << std::distance(first, it);
+            EXPECT_EQ(position.line_number, expected.line_number)
+                << "offset=" << std::distance(first, it);
+            EXPECT_EQ(position.column_number, expected.column_number)
+                << "offset=" << std::distance(first, it);
+            if (it == last)
+                break;
+        }
+    }
+
+    std::string const inputs[] = {
+        "",
+        "no line breaks",
+        "\n",
+        "\n\n\n",
+        "one\ntwo\nthree",
+        "one\r\ntwo\r\n\r\nthree\r\n",
+        "cr\rcr\r\rlf-cr\n\rend",
+        "vt\vff\fmixed\r\n\n\r",
+        // Long enough to use the SIMD path, with breaks on either side of
+        // each block boundary.
+        std::string(15, 'a') + "\r\n" + std::string(29, 'b') + "\n\n" +
+            std::string(31, 'c') + "\r" + std::string(32, 'd') + "\r\n" +
+            std::string(70, 'e') + "\f\v",
+    };
+}
+
+TEST(line_index, matches_find_line_position)
+{
+    for (std::string const & input : inputs) {
+        check_all_positions(input.begin(), input.end());
+        check_all_positions(input.c_str(), input.c_str() + input.size());
+    }
+}
+
+TEST(line_index, utf)
+{
+    // U+0085, U+2028 and U+2029 are line breaks too.
+    std::string const input =
+        "\xc2\x85one\xe2\x80\xa8two\r\n\xe2\x80\xa9\xce\x94three\xc2\x85";
+    auto const r = input | bp::as_utf32;
+    check_all_positions(r.begin(), r.end());
+}
+
+TEST(line_index, write_formatted_message)
+{
+    std::string input;
+    for (int i = 0; i < 100; ++i) {
+        input += "line " + std::to_string(i) + "\r\n";
+    }
+    bp::line_index<std::string::const_iterator> const index(
+        input.cbegin(), input.cend());
+    for (auto offset : {0, 5, 7, 8, 130, (int)input.size() - 3}) {
+        auto const it = input.cbegin() + offset;
+        std::ostringstream expected;
+        bp::write_formatted_message(
+            expected, "file.txt", input.cbegin(), it, input.cend(), "oops");
+        std::ostringstream actual;
+        bp::write_formatted_message(
+            actual, "file.txt", index, it, input.cend(), "oops");
+        EXPECT_EQ(actual.str(), expected.str()) << "offset=" << offset;
+    }
+}
+
+TEST(line_index, error_handlers)
+{
+    auto const warn_each = bp::omit[*(
+        bp::char_('x')[([](auto & ctx) {
+            _report_warning(ctx, "found an x", _where(ctx).begin());
+        })] |
+        bp::char_)];
+
+    std::string input;
+    for (int i = 0; i < 50; ++i) {
+        input += "ab\nc" + std::string(i, 'x') + "\r\n";
+    }
+
+    std::vector<std::string> expected;
+    for (auto it = input.cbegin(); it != input.cend(); ++it) {
+        if (*it != 'x')
+            continue;
+        std::ostringstream oss;
+        bp::write_formatted_message(
+            oss, "file.txt", input.cbegin(), it, input.cend(), "found an x");
+        expected.push_back(oss.str());
+    }
+
+    // Random access input uses the line index; the list does not.
+    std::vector<std::string> warnings;
+    bp::callback_error_handler const eh(
+        {},
+        [&](std::string const & msg) { warnings.push_back(msg); },
+        "file.txt");
+    EXPECT_TRUE(bp::parse(input, bp::with_error_handler(warn_each, eh)));
+    EXPECT_EQ(warnings, expected);
+
+    warnings.clear();
+    std::list<char> const list(input.begin(), input.end());
+    EXPECT_TRUE(bp::parse(list, bp::with_error_handler(warn_each, eh)));
+    EXPECT_EQ(warnings, expected);
+
+    std::ostringstream oss;
+    bp::stream_error_handler const stream_eh("file.txt", oss, oss);
+    EXPECT_TRUE(bp::parse(input, bp::with_error_handler(warn_each, stream_eh)));
+    std::string all_expected;
+    for (auto const & msg : expected) {
+        all_expected += msg;
+    }
+    EXPECT_EQ(oss.str(), all_expected);
+}
@@ -0,0 +1,115 @@
+/**
+ *   Copyright (C) 2024 T. Zachary Laine
+ *
+ *   Distributed under the Boost Software License, Version 1.0. (See
+ *   accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/parser/mapped_file.hpp>
+#include <boost/parser/replace.hpp>
+#include <boost/parser/search.hpp>
+#include <boost/parser/split.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+
+namespace bp = boost::parser;
+
+namespace {
+    std::string write_file(std::string const & name, std::string const & contents)
+    {
+        std::string const path = ::testing::TempDir() + name;
+        std::ofstream ofs(path, std::ios_base::binary);
+        ofs << contents;
+        return path;
+    }
+}
+
+TEST(mapped_file, parse)
+{
+    std::string const contents = "1, 2, 3, 42";
+    std::string const path = write_file("mapped_file_parse.txt", contents);
+
+    bp::mapped_file const file(path);
+    EXPECT_EQ(file.size(), contents.size());
+    EXPECT_EQ(std::string_view(file), contents);
+    static_assert(std::is_same_v<decltype(file.begin()), char const *>);
+
+    auto const result = bp::parse(file, bp::int_ % ',', bp::ws);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(*result, std::vector<int>({1, 2, 3, 42}));
+}
+
+#if !defined(_MSC_VER) || BOOST_PARSER_USE_CONCEPTS
+TEST(mapped_file, search_split_replace)
+{
+    std::string const contents = "a 12 b 345 c";
+    std::string const path = write_file("mapped_file_search.txt", contents);
+    bp::mapped_file const file(path);
+
+    {
+        std::vector<std::string> matches;
+        for (auto subrange : bp::search_all(file, +bp::digit)) {
+            matches.emplace_back(subrange.begin(), subrange.end());
+        }
+        EXPECT_EQ(matches, std::vector<std::string>({"12", "345"}));
+    }
+    {
+        std::vector<std::string> pieces;
+        for (auto subrange : bp::split(file, +bp::digit)) {
+            pieces.emplace_back(subrange.begin(), subrange.end());
+        }
+        EXPECT_EQ(pieces, std::vector<std::string>({"a ", " b ", " c"}));
+    }
+    {
+        std::string replaced;
+        for (auto subrange : bp::replace(file, +bp::digit, "#")) {
+            replaced.append(subrange.begin(), subrange.end());
+        }
+        EXPECT_EQ(replaced, "a # b # c");
+    }
+}
+#endif
+
+TEST(mapped_file, empty_and_missing_files)
+{
+    {
+        std::string const path = write_file("mapped_file_empty.txt", "");
+        bp::mapped_file const file(path);
+        EXPECT_TRUE(file.empty());
+        EXPECT_EQ(file.begin(), file.end());
+        EXPECT_TRUE(bp::parse(file, *bp::char_));
+        EXPECT_FALSE(bp::parse(file, +bp::char_));
+    }
+    {
+        std::error_code ec;
+        bp::mapped_file const file(
+            ::testing::TempDir() + "mapped_file_does_not_exist.txt", ec);
+        EXPECT_TRUE(ec);
+        EXPECT_TRUE(file.empty());
+    }
+#if BOOST_PARSER_USE_EXCEPTIONS
+    EXPECT_THROW(
+        bp::mapped_file(::testing::TempDir() + "mapped_file_does_not_exist.txt"),
+        std::system_error);
+#endif
+}
+
+TEST(mapped_file, move)
+{
+    std::string const path = write_file("mapped_file_move.txt", "abc");
+    bp::mapped_file file(path);
+    bp::mapped_file other(std::move(file));
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(std::string_view(other), "abc");
+
+    file = std::move(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(std::string_view(file), "abc");
+
+    file = bp::mapped_file();
+    EXPECT_TRUE(file.empty());
+}
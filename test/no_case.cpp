@@ -165,6 +165,34 @@ TEST(no_case, match_any_within_string)
     }
 }
 
+TEST(no_case, latin1_char_sets)
+{
+    EXPECT_TRUE(parse(U"A", no_case[char_("abc")]));
+    EXPECT_TRUE(parse("A", no_case[char_("abc")]));
+    EXPECT_FALSE(parse(U"A", char_("abc")));
+    EXPECT_FALSE(parse(U"d", no_case[char_("abc")]));
+
+    EXPECT_TRUE(parse(U"É", no_case[char_(U"xé")]));
+    EXPECT_TRUE(parse(U"é", no_case[char_(U"xÉ")]));
+    EXPECT_FALSE(parse(U"É", char_(U"xé")));
+    EXPECT_FALSE(parse(U"÷", no_case[char_(U"x×")]));
+    EXPECT_TRUE(parse(U"µ", no_case[char_(U"μ")]));
+    EXPECT_TRUE(parse(U"μ", no_case[char_(U"µ")]));
+
+    // 'ß' matches only where its case folding "ss" appears.
+    EXPECT_TRUE(parse(U"ß", no_case[char_("sS")]));
+    EXPECT_FALSE(parse(U"ß", no_case[char_("s")]));
+    EXPECT_FALSE(parse(U"ß", no_case[char_("sxs")]));
+    EXPECT_TRUE(parse(U"S", no_case[char_(U"ß")]));
+    EXPECT_TRUE(parse(U"ẞ", no_case[char_(U"ß")]));
+
+    // Code points outside Latin-1 can still match case insensitively.
+    EXPECT_TRUE(parse(U"\u212a", no_case[char_("k")])); // KELVIN SIGN
+    EXPECT_FALSE(parse(U"\u212a", char_("k")));
+    EXPECT_TRUE(parse(U"\u017f", no_case[char_("s")])); // LONG S
+    EXPECT_FALSE(parse(U"\u0101", no_case[char_("a")]));
+}
+
 constexpr auto capital_sharp_s = u8"ẞ"; // U+1E9E
 constexpr auto small_sharp_s = u8"ß";   // U+00DF
 constexpr auto double_s = u8"sS";       // U+0073 U+0073
@@ -359,12 +387,11 @@ TEST(no_case, detail_no_case_mismatch)
 {
     constexpr auto mixed_sharp_s1 = U"ẞs";
     constexpr auto mixed_sharp_s2 = U"sẞ";
-    auto const result = detail::no_case_aware_string_mismatch(
+    auto const result = detail::no_case_aware_string_mismatch<true>(
         mixed_sharp_s1,
         detail::text::null_sentinel,
         mixed_sharp_s2,
-        detail::text::null_sentinel,
-        true);
+        detail::text::null_sentinel);
     EXPECT_TRUE(result.first == detail::text::null_sentinel);
     EXPECT_TRUE(result.second == detail::text::null_sentinel);
 }
@@ -538,3 +565,171 @@ TEST(no_case, longer_multi_code_point_mapping)
         }
     }
 }
+
+namespace {
+    rule<struct keyword_tag, std::string> const keyword = "keyword";
+    auto const keyword_def = string("select") >> char_('a', 'z');
+    BOOST_PARSER_DEFINE_RULES(keyword);
+}
+
+TEST(no_case, context_type)
+{
+    // Whether a parser is inside no_case[] is known at compile time.
+    {
+        std::vector<bool> no_cases;
+        auto const record = [&](auto & ctx) {
+            static_assert(std::is_same_v<decltype(_no_case(ctx)), bool>);
+            no_cases.push_back(_no_case(ctx));
+        };
+        auto const p = eps[record] >>
+                       no_case[eps[record] >> no_case[eps[record]]] >>
+                       eps[record];
+        EXPECT_TRUE(parse("", p));
+        EXPECT_EQ(no_cases, (std::vector<bool>{false, true, true, false}));
+    }
+
+    // The same rule can be used both inside and outside no_case[].
+    {
+        auto const p = keyword >> ' ' >> no_case[keyword];
+        auto const result = parse("selectx SeLeCtY", p);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(
+            *result,
+            (tuple<std::string, std::string>("selectx", "SeLeCtY")));
+        EXPECT_FALSE(parse("SELECTx SeLeCtY", p));
+        EXPECT_FALSE(parse("selectx SeLeCtY", keyword >> ' ' >> keyword));
+    }
+
+    // A memoized parser keeps separate results inside and outside no_case[].
+    {
+        auto const m = memoize[keyword];
+        auto const p = (m >> '!') | no_case[m >> '?'] | (m >> '.');
+        EXPECT_TRUE(parse("SELECTX?", p));
+        EXPECT_TRUE(parse("selectx.", p));
+        EXPECT_FALSE(parse("SELECTX.", p));
+    }
+}
+
+TEST(no_case, detail_case_fold_table)
+{
+    // Every code point folds as the generated mappings say, by the same
+    // search of those mappings that case_fold() once did.
+    auto const expected_fold = [](char32_t cp) {
+        std::vector<char32_t> retval;
+        for (auto const & range : detail::mapping_ranges) {
+            if (range.cp_first_ <= cp && cp < range.cp_last_ &&
+                (cp - range.cp_first_) % range.stride_ == 0) {
+                retval.push_back(
+                    detail::single_mapping_cps
+                        [range.first_idx_ +
+                         (cp - range.cp_first_) / range.stride_]);
+                return retval;
+            }
+        }
+        for (auto const & mapping : detail::long_mappings) {
+            if (mapping.cp_ == cp) {
+                for (auto it = mapping.mapping_; *it; ++it) {
+                    retval.push_back(*it);
+                }
+                return retval;
+            }
+        }
+        retval.push_back(cp);
+        return retval;
+    };
+
+    // There are no case foldings past the SMP.
+    int mismatches = 0;
+    for (char32_t cp = 0; cp < 0x20000; ++cp) {
+        detail::case_fold_array_t folded;
+        auto const last = detail::case_fold(cp, folded.begin());
+        std::vector<char32_t> const result(folded.begin(), last);
+        if (result != expected_fold(cp) && mismatches++ < 10)
+            ADD_FAILURE() << "cp=" << std::hex << (uint32_t)cp;
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(no_case, detail_ascii_no_case_compare)
+{
+    using detail::ascii_no_case_result;
+    auto const naive = [](std::string const & input,
+                          std::string const & literal) {
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            unsigned char const c = input[i];
+            if (0x80 <= c)
+                return ascii_no_case_result::not_ascii;
+            if (std::tolower(c) != std::tolower((unsigned char)literal[i]))
+                return ascii_no_case_result::mismatch;
+        }
+        return ascii_no_case_result::match;
+    };
+
+    std::string const chars = "aAzZ@`[{_09 -~\x7f\x80\xc3";
+    uint32_t state = 1;
+    auto const next = [&state] {
+        state = state * 1103515245 + 12345;
+        return state >> 16;
+    };
+    for (int n : {1, 2, 7, 8, 9, 15, 16, 17, 31, 33, 40}) {
+        for (int trial = 0; trial < 2000; ++trial) {
+            std::string literal(n, ' ');
+            std::string input(n, ' ');
+            for (int i = 0; i < n; ++i) {
+                // Keep the literal ASCII.
+                literal[i] = chars[next() % (chars.size() - 2)];
+                input[i] = next() % 4 ? literal[i] ^ (next() % 2 ? 0x20 : 0)
+                                      : chars[next() % chars.size()];
+            }
+            auto const expected = naive(input, literal);
+            auto const result = detail::ascii_no_case_compare(
+                input.data(), literal.data(), n);
+            // Non-ASCII input may be reported even after a mismatch; the
+            // caller falls back to case folding either way.
+            if (result == ascii_no_case_result::not_ascii) {
+                EXPECT_TRUE(
+                    input.find_first_of("\x80\xc3") != std::string::npos)
+                    << input << " " << literal;
+            } else {
+                EXPECT_EQ(result, expected) << input << " " << literal;
+            }
+        }
+    }
+}
+
+TEST(no_case, ascii_string_literals)
+{
+    std::string const long_header = "Access-Control-Allow-Credentials";
+    auto const p = no_case[string("Content-Type")];
+    auto const long_p = no_case[string("access-control-allow-credentials")];
+
+    EXPECT_EQ(*parse(std::string("cONTENT-tYPE"), p), "cONTENT-tYPE");
+    EXPECT_EQ(*parse(std::string("content-type"), p), "content-type");
+    EXPECT_FALSE(parse(std::string("content_type"), p));
+    EXPECT_FALSE(parse(std::string("content-typ"), p));
+    EXPECT_FALSE(parse(std::string("content-type2"), p));
+    EXPECT_EQ(*parse(long_header, long_p), long_header);
+    EXPECT_FALSE(parse(long_header.substr(0, 31) + "X", long_p));
+    EXPECT_FALSE(parse(long_header.substr(0, 31), long_p));
+
+    // Only letters are compared without regard to case.
+    EXPECT_TRUE(parse(std::string("[@]"), no_case[string("[@]")]));
+    EXPECT_FALSE(parse(std::string("{`}"), no_case[string("[@]")]));
+
+    // Non-ASCII input is still case folded; U+00DF folds to "ss".
+    std::string const strasse = "STRA\xc3\x9f" "E";
+    EXPECT_TRUE(
+        parse(strasse | as_utf32, no_case[string("strasse")]));
+    EXPECT_FALSE(parse(strasse, no_case[string("strasse")]));
+    EXPECT_EQ(
+        parse(strasse, no_case[string("STRA\xc3\x9f" "E")]),
+        std::optional<std::string>(strasse));
+
+    // The attribute is the matched input, with its case unchanged.
+    std::string const input = "SELECT x FROM t";
+    auto const select = no_case[string("select")] >> " x " >>
+                        no_case[string("from")] >> " t";
+    auto const result = parse(input, select);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(*result, (tuple<std::string, std::string>("SELECT", "FROM")));
+}
@@ -0,0 +1,206 @@
+/**
+ *   Copyright (C) 2024 T. Zachary Laine
+ *
+ *   Distributed under the Boost Software License, Version 1.0. (See
+ *   accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/parser/parallel_parse.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <sstream>
+
+
+namespace bp = boost::parser;
+
+namespace {
+    auto const record = *(bp::char_ - ',') >> ',' >> bp::int_ >> bp::eol;
+    using record_type = bp::tuple<std::string, int>;
+
+    std::string records(int n)
+    {
+        std::string retval;
+        for (int i = 0; i < n; ++i) {
+            retval += std::string(i % 7, 'a' + i % 26) + ',' +
+                      std::to_string(i * 3) + '\n';
+        }
+        return retval;
+    }
+
+    struct count_tag
+    {};
+    bp::callback_rule<count_tag, int> const count = "count";
+    auto const count_def = bp::int_;
+    BOOST_PARSER_DEFINE_RULES(count);
+
+    struct summing_callbacks
+    {
+        void operator()(count_tag, int x) const
+        {
+            std::lock_guard<std::mutex> lock(*mutex_);
+            *sum_ += x;
+            ++*calls_;
+        }
+        std::mutex * mutex_;
+        long long * sum_;
+        int * calls_;
+    };
+}
+
+TEST(parallel_parse, matches_parse)
+{
+    std::string const input = records(1000);
+    auto const expected = bp::parse(input, *record);
+    EXPECT_TRUE(expected);
+    EXPECT_EQ(expected->size(), 1000u);
+
+    for (std::size_t threads : {1, 2, 3, 7, 64, 1500}) {
+        auto const result = bp::parallel_parse(input, '\n', *record, threads);
+        EXPECT_TRUE(result) << "threads=" << threads;
+        EXPECT_EQ(*result, *expected) << "threads=" << threads;
+    }
+
+    // A parser can be the delimiter, too.
+    auto const result = bp::parallel_parse(input, bp::eol, *record, 5);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(*result, *expected);
+
+    auto const default_threads = bp::parallel_parse(input, '\n', *record);
+    EXPECT_TRUE(default_threads);
+    EXPECT_EQ(*default_threads, *expected);
+}
+
+TEST(parallel_parse, edge_cases)
+{
+    // No input.
+    {
+        auto const result = bp::parallel_parse("", '\n', *record, 4);
+        EXPECT_TRUE(result);
+        EXPECT_TRUE(result->empty());
+    }
+    // Fewer records than threads, and a last record with no delimiter.
+    {
+        auto const result =
+            bp::parallel_parse("a,1\nb,2", ';', *(bp::char_ - ';'), 8);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, "a,1\nb,2");
+    }
+    {
+        auto const result = bp::parallel_parse(
+            std::string_view("1;2;3"), ';', bp::int_ % ';', 3);
+        // The chunks are "1;", "2;" and "3", and "1;" is not an int_ % ';'.
+        EXPECT_FALSE(result);
+    }
+    // No attribute.
+    {
+        std::string const input = records(100);
+        EXPECT_TRUE(bp::parallel_parse(input, '\n', bp::omit[*record], 4));
+        EXPECT_FALSE(
+            bp::parallel_parse(input + "x\n", '\n', bp::omit[*record], 4));
+    }
+}
+
+TEST(parallel_parse, failure_and_skipper)
+{
+    std::string input;
+    for (int i = 0; i < 200; ++i) {
+        input += " " + std::to_string(i) + " ;\n";
+    }
+    auto const ints = *(bp::int_ >> ';');
+    auto const result = bp::parallel_parse(input, '\n', ints, bp::ws, 6);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(result->size(), 200u);
+    EXPECT_EQ(result->back(), 199);
+
+    input.insert(input.size() / 2, "x");
+    EXPECT_FALSE(bp::parallel_parse(input, '\n', ints, bp::ws, 6));
+}
+
+TEST(parallel_parse, error_positions)
+{
+    std::string input;
+    for (int i = 0; i < 200; ++i) {
+        input += std::to_string(i) + (i == 150 ? "x;\n" : ";\n");
+    }
+    std::ostringstream errors;
+    bp::stream_error_handler error_handler("input", errors);
+    auto const warn_at_100 = [](auto & ctx) {
+        if (_attr(ctx) == 100)
+            _report_warning(ctx, "one hundred");
+    };
+    auto const ints = *(bp::int_[warn_at_100] > bp::lit(';') >> '\n');
+
+    // Diagnostics give positions in the whole input, not in the chunk
+    // being parsed.
+    EXPECT_FALSE(bp::parallel_parse(
+        input, '\n', bp::with_error_handler(ints, error_handler), 4));
+    std::string const messages = errors.str();
+    EXPECT_NE(messages.find("input:101:0: one hundred"), std::string::npos)
+        << messages;
+    EXPECT_NE(
+        messages.find("input:151:3: error: Expected ';' here:"),
+        std::string::npos)
+        << messages;
+}
+
+TEST(parallel_parse, globals)
+{
+    struct globals_t
+    {
+        int records = 0;
+    };
+    globals_t globals;
+    auto const counting_record =
+        record >> bp::eps[([](auto & ctx) { ++_globals(ctx).records; })];
+    std::string const input = records(100);
+    auto const result = bp::parallel_parse(
+        input, '\n', bp::with_globals(*counting_record, globals), 4);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(result->size(), 100u);
+    // Each chunk is parsed with its own copy of the globals.
+    EXPECT_EQ(globals.records, 0);
+}
+
+TEST(parallel_parse, callbacks)
+{
+    std::string input;
+    long long expected_sum = 0;
+    for (int i = 0; i < 500; ++i) {
+        input += std::to_string(i) + '\n';
+        expected_sum += i;
+    }
+
+    std::mutex mutex;
+    long long sum = 0;
+    int calls = 0;
+    summing_callbacks const callbacks{&mutex, &sum, &calls};
+
+    EXPECT_TRUE(bp::parallel_callback_parse(
+        input, '\n', *(count >> '\n'), callbacks, 4));
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(calls, 500);
+
+    sum = 0;
+    calls = 0;
+    EXPECT_TRUE(bp::parallel_callback_parse(
+        input, '\n', *count, bp::ws, callbacks, 3));
+    EXPECT_EQ(sum, expected_sum);
+    EXPECT_EQ(calls, 500);
+}
+
+#if BOOST_PARSER_USE_EXCEPTIONS
+TEST(parallel_parse, exceptions)
+{
+    std::string const input = records(100);
+    auto const throwing_record = record[([](auto & ctx) {
+        if (bp::get(_attr(ctx), bp::llong<1>{}) == 150)
+            throw std::runtime_error("150");
+    })];
+    EXPECT_THROW(
+        bp::parallel_parse(input, '\n', *throwing_record, 4),
+        std::runtime_error);
+}
+#endif
@@ -364,6 +364,44 @@ TEST(parser, basic)
     }
 }
 
+TEST(parser, string_literals)
+{
+    {
+        std::string const str = "null";
+        auto first = str.begin();
+        EXPECT_FALSE(prefix_parse(first, str.end(), string("nullable")));
+        EXPECT_EQ(first, str.begin());
+        EXPECT_FALSE(parse(str, string("nul!")));
+        EXPECT_FALSE(parse(str, string("Null")));
+        EXPECT_EQ(*parse(str, string("null")), "null");
+        EXPECT_EQ(*prefix_parse(first, str.end(), string("nu")), "nu");
+        EXPECT_EQ(*first, 'l');
+    }
+    {
+        std::string const str = "\xc3\xa9t\xc3\xa9!";
+        EXPECT_EQ(
+            *parse(str, string("\xc3\xa9t\xc3\xa9") >> '!'),
+            "\xc3\xa9t\xc3\xa9");
+        EXPECT_FALSE(parse(str, string("\xc3\xa9t\xc3\xa8") >> '!'));
+    }
+    {
+        std::string const str = "true,false";
+        auto const p = (string("true") | string("false")) % ',';
+        EXPECT_EQ(
+            *parse(str, p), std::vector<std::string>({"true", "false"}));
+        EXPECT_EQ(
+            *parse(str | as_utf32, p),
+            std::vector<std::string>({"true", "false"}));
+        EXPECT_FALSE(parse("true,fals" | as_utf32, p));
+        EXPECT_FALSE(parse("true,False" | as_utf32, p));
+    }
+    {
+        auto const result =
+            parse("\xc3\xa9t\xc3\xa9" | as_utf32, string("\xc3\xa9t\xc3\xa9"));
+        EXPECT_TRUE(result);
+    }
+}
+
 TEST(parser, int_uint)
 {
     {
@@ -1197,6 +1235,117 @@ TEST(parser, string_view)
 }
 #endif
 
+TEST(parser, views)
+{
+    {
+        std::string const str = "ab,cd,,ef";
+        auto const result = parse(str, views[*(char_ - ',') % ',']);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::vector<std::string_view>> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(
+            *result,
+            std::vector<std::string_view>({"ab", "cd", "", "ef"}));
+        EXPECT_EQ((*result)[0].data(), str.data());
+        EXPECT_EQ((*result)[3].data(), str.data() + 7);
+    }
+    {
+        char const * str = "key = value";
+        auto const result = parse(
+            str,
+            views[lexeme[+char_('a', 'z')] >> '=' >> lexeme[+char_('a', 'z')]],
+            ws);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<tuple<std::string_view, std::string_view>>
+                          const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(get(*result, llong<0>{}), "key");
+        EXPECT_EQ(get(*result, llong<1>{}), "value");
+        EXPECT_EQ(get(*result, llong<1>{}).data(), str + 6);
+    }
+    {
+        std::string const str = "12 abc";
+        auto const result = parse(str, views[raw[int_] >> ' ' >> raw[*char_]]);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<tuple<std::string_view, std::string_view>>
+                          const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(get(*result, llong<0>{}), "12");
+        EXPECT_EQ(get(*result, llong<1>{}), "abc");
+    }
+    {
+        // Repetitions of non-character parsers, and delimited repetitions,
+        // are unaffected.
+        std::string const str = "1,2;x,y";
+        auto const result =
+            parse(str, views[(int_ % ',') >> ';' >> (char_ % ',')]);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<
+                          tuple<std::vector<int>, std::string>> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(get(*result, llong<0>{}), std::vector<int>({1, 2}));
+        EXPECT_EQ(get(*result, llong<1>{}), "xy");
+    }
+    {
+        // Only repetitions of parsers that match a single char produce
+        // views; here, the text matched includes the backslash.
+        std::string const str = "a\\bc";
+        auto const result = parse(str, views[*('\\' >> char_ | char_)]);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::string> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, "abc");
+    }
+    {
+        // Nor do repetitions that skip anything.
+        std::string const str = "a b c";
+        auto const result = parse(str, views[*char_], ws);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::string> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, "abc");
+
+        auto const skip_result =
+            parse(str, views[lexeme[char_ >> ' ' >> skip[*char_]]], ws);
+        static_assert(std::is_same_v<
+                      decltype(skip_result),
+                      std::optional<std::string> const>);
+        EXPECT_TRUE(skip_result);
+        EXPECT_EQ(*skip_result, "abc");
+
+        auto const lexeme_result = parse(str, views[lexeme[*char_]], ws);
+        static_assert(std::is_same_v<
+                      decltype(lexeme_result),
+                      std::optional<std::string_view> const>);
+        EXPECT_TRUE(lexeme_result);
+        EXPECT_EQ(*lexeme_result, "a b c");
+    }
+    {
+        // Non-contiguous input gets the usual attributes.
+        std::string const str = "ab,cd";
+        auto const result =
+            parse(str | as_utf32, views[*(char_ - ',') % ',']);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::vector<std::string>> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<std::string>({"ab", "cd"}));
+    }
+    {
+        std::string const str = "abc";
+        EXPECT_FALSE(parse(str, views[+char_('x')]));
+        std::string_view sv = "unchanged";
+        EXPECT_TRUE(parse(str, views[*char_('a', 'c')], sv));
+        EXPECT_EQ(sv, "abc");
+    }
+}
+
 TEST(parser, delimited)
 {
     {
@@ -2169,6 +2318,202 @@ TEST(parser, combined_seq_and_or)
     }
 }
 
+namespace {
+    // Parses str with both parsers, which must consume the same input and
+    // produce the same attribute.
+    template<typename Parser, typename ReferenceParser, typename SkipParser>
+    void check_same_parse(
+        std::string const & str,
+        Parser const & parser,
+        ReferenceParser const & reference,
+        SkipParser const & skip)
+    {
+        auto first = str.begin();
+        auto const result = prefix_parse(first, str.end(), parser, skip);
+        auto reference_first = str.begin();
+        auto const reference_result =
+            prefix_parse(reference_first, str.end(), reference, skip);
+        EXPECT_EQ(!!result, !!reference_result) << '"' << str << '"';
+        EXPECT_EQ(first - str.begin(), reference_first - str.begin())
+            << '"' << str << '"';
+        EXPECT_TRUE(result == reference_result) << '"' << str << '"';
+    }
+}
+
+TEST(parser, or_dispatch_on_first_char)
+{
+    // Each alternative of the reference begins with eps, which has no first
+    // set, so its alternatives are always tried in order.
+    constexpr auto parser = char_('a') | char_("xyz") | int_ | lit("hello") |
+                            char_('A', 'F') | double_ | string("inf") |
+                            (char_('q') >> 'r');
+    auto const reference = (eps >> char_('a')) | (eps >> char_("xyz")) |
+                           (eps >> int_) | (eps >> lit("hello")) |
+                           (eps >> char_('A', 'F')) | (eps >> double_) |
+                           (eps >> string("inf")) |
+                           (eps >> char_('q') >> 'r');
+
+    char const * const inputs[] = {
+        "a",  "y",   "-5",  "5.5",   "hello", "help", "C",   "G",  "q",
+        "qr", "inf", "Inf", "-n",    ".5",    "",     " a",  "é",  "\xff",
+        "xa", "+",   "-.",  "infin", "hellohello",
+    };
+    for (char const * input : inputs) {
+        check_same_parse(input, parser, reference, ws);
+        check_same_parse(input, parser, reference, blank);
+        // And where nothing is skipped.
+        check_same_parse(input, lexeme[parser], lexeme[reference], ws);
+    }
+
+    // No 'a', so that "nan" (which is not equal to itself) never comes up.
+    char const alphabet[] = "qrxyzACG01+-.infhelo \t\n";
+    uint32_t x = 42;
+    for (int i = 0; i < 2000; ++i) {
+        x = x * 1664525u + 1013904223u;
+        std::string str(x >> 29, ' ');
+        for (auto & c : str) {
+            x = x * 1664525u + 1013904223u;
+            c = alphabet[(x >> 16) % (sizeof(alphabet) - 1)];
+        }
+        check_same_parse(str, parser, reference, ws);
+        check_same_parse(str, parser, reference, blank);
+        check_same_parse(str, lexeme[parser], lexeme[reference], ws);
+    }
+
+    {
+        // The first sets do not apply inside no_case[].
+        auto const p = no_case[lit("abc") | lit("x")];
+        EXPECT_TRUE(parse("ABC", p));
+        EXPECT_TRUE(parse("X", p));
+        EXPECT_FALSE(parse("Y", p));
+    }
+    {
+        // Non-ASCII chars go to every alternative.
+        auto const p = char_('a') | char_(U'é');
+        EXPECT_TRUE(parse(u8"é" | as_utf32, p));
+        EXPECT_FALSE(parse(u8"è" | as_utf32, p));
+    }
+}
+
+namespace {
+    // Records the expectation failures passed to it without throwing, and
+    // counts the parse_errors passed to it after being thrown.
+    struct recording_error_handler : default_error_handler
+    {
+        template<typename Iter, typename Sentinel>
+        error_handler_result operator()(
+            Iter first, Sentinel, expectation_failure<Iter> const & e) const
+        {
+            ++failures;
+            offset = std::distance(first, e.iter);
+            what = e.what();
+            EXPECT_EQ(e.to_parse_error().what(), what);
+            return result;
+        }
+        template<typename Iter, typename Sentinel>
+        error_handler_result
+        operator()(Iter, Sentinel, parse_error<Iter> const &) const
+        {
+            ++thrown;
+            return error_handler_result::fail;
+        }
+
+        error_handler_result result = error_handler_result::fail;
+        mutable int failures = 0;
+        mutable int thrown = 0;
+        mutable std::ptrdiff_t offset = -1;
+        mutable std::string what;
+    };
+
+    // Only takes parse_errors, so expectation failures are thrown.
+    struct throwing_error_handler : default_error_handler
+    {
+        template<typename Iter, typename Sentinel>
+        error_handler_result
+        operator()(Iter, Sentinel, parse_error<Iter> const &) const
+        {
+            return error_handler_result::fail;
+        }
+    };
+
+    // Checks that parser fails on str, both when the expectation failure is
+    // thrown and when it is not, that it is reported once, at offset, and
+    // that the parse stops there.
+    template<typename Parser>
+    void check_expectation_failure(
+        std::string const & str,
+        Parser const & parser,
+        std::ptrdiff_t offset,
+        std::string const & what)
+    {
+        int actions = 0;
+        auto const action = [&](auto &) { ++actions; };
+        throwing_error_handler throwing;
+        EXPECT_FALSE(parse(
+            str, with_error_handler(parser >> eps[action], throwing), ws))
+            << str;
+        recording_error_handler eh;
+        EXPECT_FALSE(
+            parse(str, with_error_handler(parser >> eps[action], eh), ws))
+            << str;
+        EXPECT_EQ(actions, 0) << str;
+        EXPECT_EQ(eh.failures, 1) << str;
+        EXPECT_EQ(eh.thrown, 0) << str;
+        EXPECT_EQ(eh.offset, offset) << str;
+        EXPECT_EQ(eh.what, what) << str;
+    }
+}
+
+TEST(parser, expectation_failure_without_throwing)
+{
+    {
+        constexpr auto parser = char_('a') >> string("b") > char_('c');
+        recording_error_handler eh;
+        std::string chars;
+        EXPECT_TRUE(parse("abc", with_error_handler(parser, eh), chars));
+        EXPECT_EQ(chars, "abc");
+        EXPECT_EQ(eh.failures, 0);
+        check_expectation_failure("abz", parser, 2, "char_('c')");
+        check_expectation_failure("a b  z", parser, 5, "char_('c')");
+    }
+    {
+        // Only the innermost failure is reported.
+        constexpr auto parser = char_('a') > (char_('b') > char_('c'));
+        check_expectation_failure("abx", parser, 2, "char_('c')");
+    }
+    // The parsers that recover from failures do not recover from these.
+    {
+        constexpr auto parser = (char_('a') > char_('b')) | char_('a');
+        check_expectation_failure("ax", parser, 1, "char_('b')");
+    }
+    {
+        constexpr auto parser = *(char_('a') > char_('b')) >> *char_;
+        check_expectation_failure("ab ab ax", parser, 7, "char_('b')");
+    }
+    {
+        constexpr auto parser = (char_('a') > char_('b')) % ',' >> *char_;
+        check_expectation_failure("ab,ax", parser, 4, "char_('b')");
+    }
+    {
+        constexpr auto parser = -(char_('a') > char_('b')) >> *char_;
+        check_expectation_failure("ax", parser, 1, "char_('b')");
+    }
+    {
+        constexpr auto parser = !(char_('a') > char_('b')) >> *char_;
+        check_expectation_failure("ax", parser, 1, "char_('b')");
+    }
+    {
+        recording_error_handler eh;
+        eh.result = error_handler_result::rethrow;
+        constexpr auto parser = char_('a') > char_('b');
+        EXPECT_THROW(
+            parse("ax", with_error_handler(parser, eh)),
+            parse_error<char const *>);
+        EXPECT_EQ(eh.failures, 1);
+        EXPECT_EQ(eh.thrown, 0);
+    }
+}
+
 TEST(parser, eol_)
 {
     {
@@ -2496,6 +2841,48 @@ TEST(parser, blank_)
     }
 }
 
+TEST(parser, ws_and_blank_skippers)
+{
+    // ws and blank skip runs of whitespace specially on contiguous chars;
+    // ws | ws and blank | blank are skipped one char at a time.
+    auto const parser = *char_("xy,");
+    uint32_t x = 42;
+    for (int i = 0; i < 5000; ++i) {
+        x = x * 1103515245u + 12345u;
+        std::string str((x >> 16) % 80, ' ');
+        for (auto & c : str) {
+            x = x * 1103515245u + 12345u;
+            c = " \t\n\r\v\fxy,\xa0"[(x >> 16) % 11];
+        }
+        {
+            auto first = str.begin();
+            auto result = prefix_parse(first, str.end(), parser, ws);
+            auto alt_first = str.begin();
+            auto alt_result =
+                prefix_parse(alt_first, str.end(), parser, ws | ws);
+            EXPECT_EQ(result, alt_result);
+            EXPECT_TRUE(first == alt_first);
+        }
+        {
+            auto first = str.begin();
+            auto result = prefix_parse(first, str.end(), parser, blank);
+            auto alt_first = str.begin();
+            auto alt_result =
+                prefix_parse(alt_first, str.end(), parser, blank | blank);
+            EXPECT_EQ(result, alt_result);
+            EXPECT_TRUE(first == alt_first);
+        }
+    }
+
+    {
+        std::string const str = "x  \t\n   \r\n                                  "
+                                "                 y ,\t\t\t\t\t\t\t\t\t\t"
+                                "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tx";
+        EXPECT_EQ(parse(str, parser, ws), std::string("xy,x"));
+        EXPECT_FALSE(parse(str, parser, blank));
+    }
+}
+
 TEST(parser, digit_)
 {
     constexpr auto parser = +digit;
@@ -2558,6 +2945,43 @@ TEST(parser, upper_)
     EXPECT_EQ(result, std::vector<uint32_t>({'A', 0x106}));
 }
 
+TEST(parser, char_set_tables)
+{
+    // Every code point in each set, and no others, is matched.
+    auto check = [](auto parser, auto const & chars) {
+        std::vector<uint32_t> sorted(std::begin(chars), std::end(chars));
+        std::sort(sorted.begin(), sorted.end());
+        for (char32_t c = 0; c < 0x20000; ++c) {
+            char32_t const * first = &c;
+            bool const expected =
+                std::binary_search(sorted.begin(), sorted.end(), c);
+            EXPECT_EQ(!!prefix_parse(first, &c + 1, parser), expected)
+                << std::hex << (uint32_t)c;
+        }
+    };
+    check(punct, detail::char_set<detail::punct_chars>::chars);
+    check(lower, detail::char_set<detail::lower_case_chars>::chars);
+    check(upper, detail::char_set<detail::upper_case_chars>::chars);
+
+    // The chars in the middle of the punct table, which is not sorted.
+    EXPECT_TRUE(parse(",", punct));
+    EXPECT_TRUE(parse("-", punct));
+    EXPECT_TRUE(parse("?", punct));
+
+    // User sets with code points outside Latin-1, in few enough blocks of
+    // 0x100 code points to be kept in bitmaps, and in too many.
+    std::u32string const few_blocks = U"a\u00e9\u03b1\u03c9\u0416\u20ac";
+    check(char_(few_blocks), few_blocks);
+    std::u32string const many_blocks =
+        U"a\u0101\u0201\u0301\u0401\u0501\U0001f600";
+    check(char_(many_blocks), many_blocks);
+    std::u16string const utf16_chars = u"x\u03b1\U0001f600";
+    check(char_(utf16_chars), std::u32string(U"x\u03b1\U0001f600"));
+    EXPECT_TRUE(parse(U"\u0391", no_case[char_(few_blocks)]));
+    EXPECT_TRUE(parse(U"\u00c9", no_case[char_(few_blocks)]));
+    EXPECT_FALSE(parse(U"\u0391", char_(few_blocks)));
+}
+
 TEST(parser, github_issue_36)
 {
     namespace bp = boost::parser;
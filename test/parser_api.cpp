@@ -6,6 +6,7 @@
  *   http://www.boost.org/LICENSE_1_0.txt)
  */
 #include <boost/parser/parser.hpp>
+#include <boost/parser/search.hpp>
 #include <boost/parser/transcode_view.hpp>
 
 #include "ill_formed.hpp"
@@ -2010,3 +2011,240 @@ TEST(parser, github_issue_78)
     EXPECT_FALSE(b);
     EXPECT_TRUE(result.empty());
 }
+
+#if defined(__cpp_lib_memory_resource)
+namespace {
+    // Makes any allocation by a std::pmr container that does not use the
+    // arena throw.
+    struct scoped_null_default_resource
+    {
+        scoped_null_default_resource() :
+            prev_(std::pmr::set_default_resource(
+                std::pmr::null_memory_resource()))
+        {}
+        ~scoped_null_default_resource()
+        {
+            std::pmr::set_default_resource(prev_);
+        }
+        std::pmr::memory_resource * prev_;
+    };
+}
+
+TEST(parser, memory_resource_attrs)
+{
+    namespace bp = boost::parser;
+    std::pmr::monotonic_buffer_resource arena;
+    scoped_null_default_resource _;
+
+    {
+        auto const p = bp::lexeme[+bp::char_('a', 'z')] % ',';
+        auto const result = bp::parse(
+            "abcdefghijklmnopqrstuvwxyz, abcdefghijklmnopqrstuvwxyz",
+            p,
+            bp::ws,
+            &arena);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::pmr::vector<std::pmr::string>> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(result->size(), 2u);
+        EXPECT_EQ(result->get_allocator().resource(), &arena);
+        for (auto const & str : *result) {
+            EXPECT_EQ(str, "abcdefghijklmnopqrstuvwxyz");
+            EXPECT_EQ(str.get_allocator().resource(), &arena);
+        }
+        EXPECT_FALSE(bp::parse("abc, 42", p, bp::ws, &arena));
+    }
+    {
+        auto const p = *('[' >> bp::int_ % ',' >> ']');
+        auto const result =
+            bp::parse("[1,2,3,4,5,6,7,8,9,10][11][12,13]", p, &arena);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(result->size(), 3u);
+        EXPECT_EQ(result->get_allocator().resource(), &arena);
+        for (auto const & ints : *result) {
+            EXPECT_EQ(ints.get_allocator().resource(), &arena);
+        }
+        EXPECT_EQ((*result)[2], std::pmr::vector<int>({12, 13}, &arena));
+    }
+    {
+        auto const p = +bp::char_('a', 'z') >> ':' >> bp::int_ % ',';
+        auto const result =
+            bp::parse("abcdefghijklmnopqrstuvwxyz:1,2,3", p, &arena);
+        EXPECT_TRUE(result);
+        using namespace bp::literals;
+        EXPECT_EQ(bp::get(*result, 0_c), "abcdefghijklmnopqrstuvwxyz");
+        EXPECT_EQ(bp::get(*result, 0_c).get_allocator().resource(), &arena);
+        EXPECT_EQ(bp::get(*result, 1_c), std::pmr::vector<int>({1, 2, 3}, &arena));
+        EXPECT_EQ(bp::get(*result, 1_c).get_allocator().resource(), &arena);
+    }
+    {
+        // A named pointer to a derived resource selects the memory resource
+        // overloads, not the ones taking an out-param attribute.
+        auto * res = &arena;
+        auto const p = bp::int_ % ',';
+        auto const result = bp::parse("1,2,3", p, res);
+        static_assert(std::is_same_v<
+                      decltype(result),
+                      std::optional<std::pmr::vector<int>> const>);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::pmr::vector<int>({1, 2, 3}, &arena));
+        EXPECT_EQ(result->get_allocator().resource(), &arena);
+
+        auto const skipped_result = bp::parse("1, 2, 3", p, bp::ws, res);
+        EXPECT_TRUE(skipped_result);
+        EXPECT_EQ(skipped_result->get_allocator().resource(), &arena);
+
+        std::pmr::memory_resource * const base_res = &arena;
+        EXPECT_TRUE(bp::parse("4,5", p, base_res));
+    }
+    {
+        // A std::string produced by the parser, inserted into a container of
+        // std::pmr::string.
+        std::pmr::vector<std::pmr::string> result(&arena);
+        EXPECT_TRUE(bp::parse(
+            "abcdefghijklmnopqrstuvwxyz;abcdefghijklmnopqrstuvwxyz",
+            bp::string("abcdefghijklmnopqrstuvwxyz") % ';',
+            result));
+        EXPECT_EQ(result.size(), 2u);
+        EXPECT_EQ(result[1].get_allocator().resource(), &arena);
+    }
+}
+#endif
+
+TEST(parser, decoded_utf32)
+{
+    namespace bp = boost::parser;
+    {
+        // Long enough that the ASCII runs before and after the non-ASCII
+        // code points are widened in chunks.
+        std::string const str =
+            "abcdefghijklmnopqrstuvwxyz r\xc3\xb4le \xe2\x82\xac"
+            "42 \xf0\x9f\x98\x80 abcdefghijklmnopqrstuvwxyz";
+        bp::decoded_utf32 const decoded(str);
+        std::u32string_view const expected =
+            U"abcdefghijklmnopqrstuvwxyz rôle €"
+            U"42 \U0001f600 abcdefghijklmnopqrstuvwxyz";
+        EXPECT_TRUE(
+            std::u32string_view(decoded.begin(), decoded.size()) == expected);
+
+        auto const p = *(bp::cp - ' ') % ' ';
+        EXPECT_EQ(bp::parse(decoded, p), bp::parse(expected, p));
+
+        // Positions map back to the original chars.
+        auto first = decoded.begin();
+        EXPECT_TRUE(bp::prefix_parse(first, decoded.end(), *(bp::cp - U'€')));
+        EXPECT_EQ(decoded.base(first) - str.begin(), 33);
+        EXPECT_EQ(decoded.base(decoded.begin() + 5) - str.begin(), 5);
+        EXPECT_EQ(decoded.base(decoded.begin() + 36) - str.begin(), 39);
+        EXPECT_EQ(decoded.base(decoded.begin() + 37) - str.begin(), 43);
+        EXPECT_EQ(decoded.base(decoded.end()), str.end());
+
+        auto const result = bp::search(decoded, bp::int_);
+        EXPECT_EQ(decoded.base(result.begin()) - str.begin(), 36);
+        EXPECT_EQ(decoded.base(result.end()) - str.begin(), 38);
+    }
+    {
+        // Ill-formed UTF-8 decodes to the same replacement characters that
+        // as_utf32 produces.
+        std::vector<std::string> const strs = {
+            "abc\x80z",
+            "abcdefghijklmnopqrstuvwxyz\xc3",
+            "\xe2\x82z\xc0\xaf\xe2\x28\xa1",
+            "\xc3\xc3\xa9 abcdefghijklmnopqrstuvwxyz"};
+        for (auto const & str : strs) {
+            bp::decoded_utf32 const decoded(str);
+            auto const expected = str | bp::as_utf32;
+            EXPECT_TRUE(std::equal(
+                decoded.begin(),
+                decoded.end(),
+                expected.begin(),
+                expected.end()));
+            auto it = expected.begin();
+            for (auto pos = decoded.begin(); pos != decoded.end();
+                 ++pos, ++it) {
+                EXPECT_EQ(decoded.base(pos), it.base());
+            }
+        }
+
+        // One U+FFFD for each maximal subpart of an ill-formed sequence.
+        std::string const str = "\xf0\x9f\x98.\xed\xa0\x80.\xf4\x90";
+        bp::decoded_utf32 const decoded(str);
+        EXPECT_TRUE(
+            std::u32string_view(decoded.begin(), decoded.size()) ==
+            U"�.���.��");
+        EXPECT_EQ(decoded.base(decoded.begin() + 1) - str.begin(), 3);
+        EXPECT_EQ(decoded.base(decoded.begin() + 5) - str.begin(), 7);
+    }
+    {
+        std::u16string const str =
+            u"abcdefghijklmnopqrstuvwxyz \U0001F600 \xdc00 \x00e9 \xd800";
+        bp::decoded_utf32 const decoded(str);
+        auto const expected = str | bp::as_utf32;
+        EXPECT_TRUE(std::equal(
+            decoded.begin(), decoded.end(), expected.begin(), expected.end()));
+        auto it = expected.begin();
+        for (auto pos = decoded.begin(); pos != decoded.end(); ++pos, ++it) {
+            EXPECT_EQ(decoded.base(pos), it.base());
+        }
+
+        // A high surrogate followed by something other than a low surrogate
+        // is replaced on its own.
+        bp::decoded_utf32 const lone_high(std::u16string(u"\xd800x"));
+        EXPECT_TRUE(
+            std::u32string_view(lone_high.begin(), lone_high.size()) ==
+            U"�x");
+    }
+    {
+        // Null-terminated strings and arrays.
+        char const * ptr = "r\xc3\xb4le";
+        bp::decoded_utf32 const from_ptr(ptr);
+        EXPECT_EQ(from_ptr.size(), 4u);
+        EXPECT_EQ(from_ptr.base(from_ptr.end()), ptr + 5);
+        bp::decoded_utf32 const from_array(u"r\x00f4le");
+        EXPECT_EQ(from_array.size(), 4u);
+        EXPECT_TRUE(bp::parse(from_array, bp::lit(U"rôle")));
+    }
+#if defined(__cpp_char8_t)
+    {
+        std::u8string const str = u8"[1, 2, \"ô\"]";
+        bp::decoded_utf32 const decoded(str);
+        auto const p = '[' >> bp::omit[bp::int_ % ','] >> ", \"" >> bp::cp >>
+                       "\"]";
+        EXPECT_TRUE(
+            bp::parse(decoded, p, bp::ws) == std::optional<char32_t>(U'ô'));
+    }
+#endif
+    {
+        // A nested decode gets its own buffer, and the larger buffer is
+        // kept for reuse on this thread.
+        std::string const outer(1000, 'a');
+        bp::decoded_utf32 decoded(outer);
+        char32_t const * outer_buffer = decoded.begin();
+        {
+            bp::decoded_utf32 const inner(std::string(10, 'b'));
+            EXPECT_TRUE(inner.begin() != outer_buffer);
+            EXPECT_EQ(inner.size(), 10u);
+        }
+        EXPECT_EQ(decoded.size(), 1000u);
+        decoded = bp::decoded_utf32(std::string(10, 'c'));
+        bp::decoded_utf32 const reused(std::string(500, 'd'));
+        EXPECT_TRUE(reused.begin() == outer_buffer);
+    }
+    {
+        // A very large buffer is freed rather than kept.
+        {
+            bp::decoded_utf32 const huge(std::string(
+                bp::detail::max_cached_utf32_capacity + 1, 'a'));
+            EXPECT_EQ(huge.size(), bp::detail::max_cached_utf32_capacity + 1);
+        }
+        EXPECT_TRUE(
+            bp::detail::cached_utf32_buffer().capacity_ <=
+            bp::detail::max_cached_utf32_capacity);
+    }
+    {
+        // This is destroyed after the thread_local cache, at exit.
+        static bp::decoded_utf32 const decoded(std::string(2000, 'e'));
+        EXPECT_EQ(decoded.size(), 2000u);
+    }
+}
@@ -0,0 +1,438 @@
+/**
+ *   Copyright (C) 2024 T. Zachary Laine
+ *
+ *   Distributed under the Boost Software License, Version 1.0. (See
+ *   accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/parser/parser.hpp>
+#include <boost/parser/transcode_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+
+namespace bp = boost::parser;
+
+namespace {
+    struct lcg64
+    {
+        uint64_t next()
+        {
+            x_ = x_ * 6364136223846793005ull + 1442695040888963407ull;
+            return x_;
+        }
+        uint64_t x_ = 42;
+    };
+
+    template<typename T, typename Bits>
+    T from_bits(Bits bits)
+    {
+        static_assert(sizeof(T) == sizeof(Bits));
+        T retval;
+        std::memcpy(&retval, &bits, sizeof(T));
+        return retval;
+    }
+
+    template<typename T>
+    bool same_bits(T x, T y)
+    {
+        return std::memcmp(&x, &y, sizeof(T)) == 0;
+    }
+}
+
+TEST(parser_numeric, precise_double_round_trip)
+{
+    lcg64 gen;
+    for (int i = 0; i < 20000; ++i) {
+        double const x = from_bits<double>(gen.next());
+        if (!std::isfinite(x))
+            continue;
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.17g", x);
+        std::string const str = buf;
+
+        auto const contiguous = bp::parse(str, bp::precise_double_);
+        EXPECT_TRUE(contiguous) << str;
+        if (contiguous) {
+            EXPECT_TRUE(same_bits(*contiguous, x)) << str;
+        }
+
+        auto const utf32 = bp::parse(str | bp::as_utf32, bp::precise_double_);
+        EXPECT_TRUE(utf32) << str;
+        if (utf32) {
+            EXPECT_TRUE(same_bits(*utf32, x)) << str;
+        }
+    }
+}
+
+TEST(parser_numeric, precise_float_round_trip)
+{
+    lcg64 gen;
+    for (int i = 0; i < 20000; ++i) {
+        float const x = from_bits<float>(uint32_t(gen.next() >> 32));
+        if (!std::isfinite(x))
+            continue;
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%.9g", x);
+        std::string const str = buf;
+
+        auto const result = bp::parse(str, bp::precise_float_);
+        EXPECT_TRUE(result) << str;
+        if (result) {
+            EXPECT_TRUE(same_bits(*result, x)) << str;
+        }
+    }
+}
+
+TEST(parser_numeric, precise_double_correct_rounding)
+{
+#if defined(__cpp_lib_to_chars)
+    {
+        // Halfway between 2^53 and 2^53 + 2; rounds to even.
+        auto const result = bp::parse("9007199254740993", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 9007199254740992.0);
+    }
+    {
+        auto const result = bp::parse("1e23", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 1e23);
+    }
+    {
+        auto const result =
+            bp::parse("2.2250738585072011e-308", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 2.2250738585072011e-308);
+    }
+    {
+        auto const result = bp::parse(
+            "0.1000000000000000055511151231257827021181583404541015625",
+            bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 0.1);
+    }
+    {
+        // Too many digits for the exact fast path.
+        auto const result =
+            bp::parse("123456789012345678901234567890", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 123456789012345678901234567890.0);
+    }
+    {
+        auto const result = bp::parse(
+            "0.000000000000000000000000000012345", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 1.2345e-29);
+    }
+    {
+        auto const result = bp::parse("4.9e-324", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 4.9e-324);
+    }
+    {
+        auto const result = bp::parse("1e22", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 1e22);
+    }
+    {
+        auto const result = bp::parse("16777217", bp::precise_float_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 16777216.0f);
+    }
+#endif
+    {
+        auto const result = bp::parse("1e-400", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 0.0);
+    }
+    {
+        auto const result = bp::parse("-1e-400", bp::precise_double_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 0.0);
+    }
+    EXPECT_FALSE(bp::parse("1e400", bp::precise_double_));
+    EXPECT_FALSE(bp::parse("1e400", bp::double_));
+}
+
+#if defined(__cpp_lib_to_chars)
+TEST(parser_numeric, precise_double_matches_from_chars)
+{
+    // Mantissas of up to 19 digits with exponents of up to +/-70 are
+    // converted without std::from_chars() where possible, including ones
+    // that are just above, at or just below halfway between two doubles.
+    lcg64 gen;
+    for (int i = 0; i < 200000; ++i) {
+        std::string str = std::to_string(gen.next() % 10000000000000000000ull);
+        if (i % 4 == 0)
+            str = std::to_string(gen.next() % 100000000000000000ull) + "5";
+        str += "e" + std::to_string(int(gen.next() % 141) - 70);
+
+        double expected = 0;
+        std::from_chars(str.data(), str.data() + str.size(), expected);
+        auto const result = bp::parse(str, bp::precise_double_);
+        EXPECT_TRUE(result) << str;
+        if (result) {
+            EXPECT_TRUE(same_bits(*result, expected)) << str;
+        }
+
+        float expected_float = 0;
+        auto const float_result = std::from_chars(
+            str.data(), str.data() + str.size(), expected_float);
+        if (float_result.ec == std::errc()) {
+            auto const result = bp::parse(str, bp::precise_float_);
+            EXPECT_TRUE(result) << str;
+            if (result) {
+                EXPECT_TRUE(same_bits(*result, expected_float)) << str;
+            }
+        }
+    }
+}
+#endif
+
+TEST(parser_numeric, precise_double_matches_double_syntax)
+{
+    char const * const inputs[] = {
+        "1",        "-1",      "+1",        "1.",         ".5",
+        "-.5",      "+.5e1",   "1e10",      "1E-10",      "1e+3",
+        "1e",       "1e+",     "1.5e3x",    ".",          "-",
+        "+",        "e5",      "",          "0x10",       "123abc",
+        "00012.50", "1..2",    "-0",        "3.14159 26", "1.e5",
+        "inf",      "-Inf",    "infinity",  "nan",        "-NaN(123)",
+        "nanx",     "in",      "1e-5-",     ".e5",        "5.e",
+    };
+    for (char const * input : inputs) {
+        std::string const str = input;
+        {
+            auto first = str.begin();
+            auto const slow = bp::prefix_parse(first, str.end(), bp::double_);
+            auto const slow_first = first;
+            first = str.begin();
+            auto const fast =
+                bp::prefix_parse(first, str.end(), bp::precise_double_);
+            EXPECT_EQ(!!slow, !!fast) << '"' << input << '"';
+            EXPECT_EQ(slow_first - str.begin(), first - str.begin())
+                << '"' << input << '"';
+            if (slow && fast) {
+                if (std::isnan(*slow)) {
+                    EXPECT_TRUE(std::isnan(*fast)) << '"' << input << '"';
+                } else {
+                    EXPECT_EQ(*slow, *fast) << '"' << input << '"';
+                }
+            }
+        }
+        {
+            auto const r = str | bp::as_utf32;
+            auto first = r.begin();
+            auto const slow = bp::prefix_parse(first, r.end(), bp::double_);
+            auto const slow_first = first;
+            first = r.begin();
+            auto const fast =
+                bp::prefix_parse(first, r.end(), bp::precise_double_);
+            EXPECT_EQ(!!slow, !!fast) << '"' << input << '"';
+            EXPECT_TRUE(slow_first == first) << '"' << input << '"';
+        }
+    }
+}
+
+TEST(parser_numeric, precise_double_in_grammar)
+{
+    {
+        auto const result =
+            bp::parse("1.5, -2.25e2 ,3", bp::precise_double_ % ',', bp::ws);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<double>({1.5, -225.0, 3.0}));
+    }
+    {
+        auto const result = bp::parse("x", bp::precise_double_ | bp::char_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(result->index(), 1u);
+    }
+}
+
+TEST(parser_numeric, json_number_syntax)
+{
+    // The JSON number grammar, spelled out.
+    auto const json_syntax = bp::raw[bp::lexeme
+        [-bp::char_('-') >>
+         (bp::char_('1', '9') >> *bp::digit | bp::char_('0')) >>
+         -(bp::char_('.') >> +bp::digit) >>
+         -(bp::char_("eE") >> -bp::char_("+-") >> +bp::digit)]];
+
+    char const * const inputs[] = {
+        "1",        "-1",      "+1",        "1.",         ".5",
+        "-.5",      "+.5e1",   "1e10",      "1E-10",      "1e+3",
+        "1e",       "1e+",     "1.5e3x",    ".",          "-",
+        "+",        "e5",      "",          "0x10",       "123abc",
+        "00012.50", "1..2",    "-0",        "3.14159 26", "1.e5",
+        "inf",      "-Inf",    "nan",       "0.5",        "-0.0e-0",
+        "012",      "-01",     "10",        "1.25E+2",    "-",
+        "123456789012345678901234567890.5e-10",
+    };
+    for (char const * input : inputs) {
+        std::string const str = input;
+        {
+            auto first = str.begin();
+            auto const expected =
+                bp::prefix_parse(first, str.end(), json_syntax);
+            auto const expected_first = first;
+            first = str.begin();
+            auto const result =
+                bp::prefix_parse(first, str.end(), bp::json_number);
+            EXPECT_EQ(!!expected, !!result) << '"' << input << '"';
+            EXPECT_EQ(expected_first - str.begin(), first - str.begin())
+                << '"' << input << '"';
+            if (expected && result) {
+                auto const value = bp::parse(
+                    std::string(expected->begin(), expected->end()),
+                    bp::precise_double_);
+                EXPECT_TRUE(value) << '"' << input << '"';
+                EXPECT_EQ(*value, *result) << '"' << input << '"';
+            }
+        }
+        {
+            auto const r = str | bp::as_utf32;
+            auto first = r.begin();
+            auto const expected = bp::prefix_parse(first, r.end(), json_syntax);
+            auto const expected_first = first;
+            first = r.begin();
+            auto const result =
+                bp::prefix_parse(first, r.end(), bp::json_number);
+            EXPECT_EQ(!!expected, !!result) << '"' << input << '"';
+            EXPECT_TRUE(expected_first == first) << '"' << input << '"';
+        }
+    }
+
+    {
+        auto const result = bp::parse(
+            "[1.5, -0, 2e3]", '[' >> bp::json_number % ',' >> ']', bp::ws);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<double>({1.5, 0.0, 2000.0}));
+    }
+    {
+        auto const result =
+            bp::parse("nan", bp::json_number | bp::string("nan"));
+        EXPECT_TRUE(result);
+        EXPECT_EQ(result->index(), 1u);
+    }
+    {
+        // Numbers too large for a double are infinite, as with strtod();
+        // numbers too small are 0.
+        double const inf = std::numeric_limits<double>::infinity();
+        auto const list = '[' >> bp::json_number % ',' >> ']';
+        std::string const str =
+            "[1e400, -1e400, 1e-400, 12345678901234567890e300]";
+        auto const result = bp::parse(str, list, bp::ws);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<double>({inf, -inf, 0.0, inf}));
+        auto const result32 = bp::parse(str | bp::as_utf32, list, bp::ws);
+        EXPECT_TRUE(result32);
+        EXPECT_EQ(*result32, *result);
+        EXPECT_FALSE(bp::parse("1e400", bp::precise_double_));
+    }
+}
+
+namespace {
+    // Parses str as contiguous chars, and through as_utf32 (which uses the
+    // one-digit-at-a-time path); both must agree.
+    template<typename Parser>
+    void check_int_paths(std::string const & str, Parser p)
+    {
+        auto first = str.begin();
+        auto const fast = bp::prefix_parse(first, str.end(), p);
+        auto const r = str | bp::as_utf32;
+        auto first32 = r.begin();
+        auto const slow = bp::prefix_parse(first32, r.end(), p);
+        EXPECT_EQ(!!fast, !!slow) << '"' << str << '"';
+        EXPECT_EQ(
+            first - str.begin(),
+            std::distance(r.begin().base(), first32.base()))
+            << '"' << str << '"';
+        if (fast && slow) {
+            EXPECT_EQ(*fast, *slow) << '"' << str << '"';
+        }
+    }
+}
+
+TEST(parser_numeric, int_contiguous_matches_generic)
+{
+    char const * const inputs[] = {
+        "0",
+        "-0",
+        "+0",
+        "000000000000000000000000000000000000000042",
+        "-",
+        "+",
+        "",
+        "x",
+        "12345678",
+        "123456789",
+        "1234567890123456",
+        "12345678x9",
+        "2147483647",
+        "2147483648",
+        "-2147483648",
+        "-2147483649",
+        "4294967295",
+        "4294967296",
+        "9223372036854775807",
+        "9223372036854775808",
+        "-9223372036854775808",
+        "-9223372036854775809",
+        "18446744073709551615",
+        "18446744073709551616",
+        "99999999999999999999999",
+        "1,2,3",
+        "7\xff",
+    };
+    for (char const * input : inputs) {
+        check_int_paths(input, bp::int_);
+        check_int_paths(input, bp::uint_);
+        check_int_paths(input, bp::short_);
+        check_int_paths(input, bp::ushort_);
+        check_int_paths(input, bp::long_long);
+        check_int_paths(input, bp::ulong_long);
+    }
+
+    lcg64 gen;
+    char const alphabet[] = "0123456789-+ ,x";
+    for (int i = 0; i < 5000; ++i) {
+        std::string str(gen.next() % 24, ' ');
+        for (auto & c : str) {
+            uint64_t const x = gen.next() >> 32;
+            c = x % 4 ? char('0' + x % 10)
+                      : alphabet[x % (sizeof(alphabet) - 1)];
+        }
+        check_int_paths(str, bp::int_);
+        check_int_paths(str, bp::uint_);
+        check_int_paths(str, bp::long_long);
+        check_int_paths(str, bp::ulong_long);
+    }
+}
+
+TEST(parser_numeric, int_in_grammar)
+{
+    {
+        auto const result =
+            bp::parse("12345678901, -7,0", bp::long_long % ',', bp::ws);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<long long>({12345678901ll, -7, 0}));
+    }
+    {
+        std::string const str = "123456789012345678901234567890";
+        EXPECT_FALSE(bp::parse(str, bp::ulong_long));
+        auto const result = bp::parse(str, bp::ulong_long | *bp::char_);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(result->index(), 1u);
+    }
+    EXPECT_EQ(*bp::parse("42", bp::int_(42)), 42);
+    EXPECT_FALSE(bp::parse("43", bp::int_(42)));
+}
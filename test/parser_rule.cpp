@@ -4,9 +4,12 @@
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 #include <boost/parser/parser.hpp>
+#include <boost/parser/transcode_view.hpp>
 
 #include <gtest/gtest.h>
 
+#include <list>
+
 
 using namespace boost::parser;
 
@@ -557,3 +560,191 @@ namespace more_about_rules_4 {
         return bp::parse(str, bp::omit[parens], bp::ws);
     }
 }
+
+namespace memoized_rules {
+    namespace bp = boost::parser;
+
+    bp::memoize_stats operand_stats;
+
+    // Each alternative of sum starts with operand, so without memoization
+    // each level of nesting triples the work.
+    bp::rule<struct sum_tag, std::string> sum = "sum";
+    bp::rule<struct operand_tag, std::string> operand = "operand";
+    auto const sum_def = bp::merge[operand >> bp::string("+") >> operand] |
+                         bp::merge[operand >> bp::string("-") >> operand] |
+                         operand;
+    auto const operand_def = +bp::digit | bp::char_('(') >> sum >> bp::char_(')');
+    BOOST_PARSER_DEFINE_RULES(sum, operand);
+
+    bp::rule<struct memo_sum_tag, std::string> memo_sum = "memo_sum";
+    bp::rule<struct memo_operand_tag, std::string> memo_operand =
+        "memo_operand";
+    auto const memo_sum_def =
+        bp::merge[memo_operand >> bp::string("+") >> memo_operand] |
+        bp::merge[memo_operand >> bp::string("-") >> memo_operand] |
+        memo_operand;
+    auto const memo_operand_def = bp::memoize(operand_stats)
+        [+bp::digit | bp::char_('(') >> memo_sum >> bp::char_(')')];
+    BOOST_PARSER_DEFINE_RULES(memo_sum, memo_operand);
+
+    // memoize[] cannot be applied to a rule with parameters, or used inside
+    // one, but a rule without parameters may use one with fixed parameters.
+    bp::rule<struct repeated_tag, std::string> repeated = "repeated";
+    bp::rule<struct pair_tag, std::string> pair = "pair";
+    bp::rule<struct pair_or_triple_tag, std::string> pair_or_triple =
+        "pair_or_triple";
+    auto const repeated_def = bp::repeat(bp::_p<0>)[bp::char_];
+    auto const pair_def = repeated.with(2);
+    auto const pair_or_triple_def = bp::memoize[pair] >> 'x' |
+                                    bp::memoize[pair] >> bp::char_;
+    BOOST_PARSER_DEFINE_RULES(repeated, pair, pair_or_triple);
+
+    std::string nested_sum(int depth)
+    {
+        std::string retval = "1";
+        for (int i = 0; i < depth; ++i) {
+            retval = "(" + retval + (i % 2 ? "-" : "+") + "2)";
+        }
+        return retval + "+3";
+    }
+}
+
+TEST(parser, memoize)
+{
+    using namespace memoized_rules;
+
+    {
+        std::string const str = nested_sum(10);
+        auto const expected = parse(str, sum);
+        EXPECT_TRUE(expected);
+
+        operand_stats = memoize_stats();
+        auto const result = parse(str, memo_sum);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, *expected);
+        EXPECT_TRUE(0u < operand_stats.hits);
+        // One miss for each position at which operand is tried.
+        EXPECT_EQ(operand_stats.misses, 22u);
+    }
+    {
+        // Results are not shared between parses, or between parses that do
+        // and do not generate attributes.
+        std::string const str = nested_sum(10);
+        operand_stats = memoize_stats();
+        EXPECT_TRUE(parse(str, omit[memo_sum]));
+        EXPECT_EQ(operand_stats.misses, 22u);
+        EXPECT_TRUE(parse(str, memo_sum));
+        EXPECT_EQ(operand_stats.misses, 44u);
+    }
+    {
+        std::string const str = "((1+2)-(3+4) ";
+        EXPECT_FALSE(parse(str, sum, ws));
+        EXPECT_FALSE(parse(str, memo_sum, ws));
+    }
+    {
+        std::string const str = " ( (1 + 2) - (3+4) ) - 5";
+        auto const expected = parse(str, sum, ws);
+        EXPECT_TRUE(expected);
+        auto const result = parse(str, memo_sum, ws);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, *expected);
+    }
+    {
+        std::string const str = nested_sum(4);
+        auto const expected = parse(str, sum);
+        EXPECT_TRUE(expected);
+        operand_stats = memoize_stats();
+        auto const result = parse(str | as_utf32, memo_sum);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, *expected);
+        EXPECT_TRUE(0u < operand_stats.hits);
+    }
+    {
+        // Without random access there are no positions to key results by,
+        // so memoize[] does nothing.
+        std::string const str = nested_sum(4);
+        auto const expected = parse(str, sum);
+        EXPECT_TRUE(expected);
+        std::list<char> const list(str.begin(), str.end());
+        operand_stats = memoize_stats();
+        auto const result = parse(list, memo_sum);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, *expected);
+        EXPECT_EQ(operand_stats.hits, 0u);
+        EXPECT_EQ(operand_stats.misses, 0u);
+    }
+    {
+        // Every memoize[r] of the same unparameterized rule r shares r's
+        // results.
+        memoize_stats stats;
+        auto const memo_operand = memoize(stats)[operand];
+        auto const p = memo_operand >> '+' >> memo_operand |
+                       memo_operand >> '-' >> memo_operand >> '!' |
+                       memo_operand;
+        std::string const str = "12-3";
+        auto first = str.begin();
+        EXPECT_TRUE(prefix_parse(first, str.end(), p));
+        EXPECT_EQ(first, str.begin() + 2);
+        EXPECT_EQ(stats.hits, 2u);
+        EXPECT_EQ(stats.misses, 2u);
+    }
+    {
+        // With room for only one result, the result at 0 is forgotten once
+        // the one at 3 is recorded.
+        memoize_stats stats;
+        auto const memo_operand = memoize(1, stats)[operand];
+        auto const p = memo_operand >> '+' >> memo_operand |
+                       memo_operand >> '-' >> memo_operand >> '!' |
+                       memo_operand;
+        std::string const str = "12-3";
+        auto first = str.begin();
+        EXPECT_TRUE(prefix_parse(first, str.end(), p));
+        EXPECT_EQ(first, str.begin() + 2);
+        EXPECT_EQ(stats.hits, 1u);
+        EXPECT_EQ(stats.misses, 3u);
+    }
+    {
+        // Inside a sequence, the attribute of memoize[p] may be merged with
+        // those before it; p's elements are appended to them, on a hit as
+        // well as on a miss.
+        memoize_stats stats;
+        auto const memo_bs = memoize(stats)[+char_('b')];
+        auto const p = char_('a') >> memo_bs >> 'y' |
+                       char_('a') >> memo_bs >> char_('x');
+        auto const result = parse("abbx", p);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, "abbx");
+        EXPECT_EQ(stats.hits, 1u);
+        EXPECT_EQ(stats.misses, 1u);
+        EXPECT_EQ(*parse("abc", char_('a') >> memoize[+char_]), "abc");
+    }
+    {
+        EXPECT_EQ(*parse("abx", pair_or_triple), "ab");
+        EXPECT_EQ(*parse("abc", pair_or_triple), "abc");
+        EXPECT_FALSE(parse("abcd", pair_or_triple));
+
+        using param_rule_t = decltype(repeated.with(2))::parser_type;
+        using context_t = decltype(detail::make_context(
+            std::declval<char const *>(),
+            std::declval<char const *>(),
+            std::declval<bool &>(),
+            std::declval<int &>(),
+            std::declval<default_error_handler const &>(),
+            std::declval<detail::nope &>(),
+            std::declval<detail::symbol_table_tries_t &>()));
+        using param_context_t = decltype(detail::make_rule_context(
+            std::declval<context_t const &>(),
+            std::declval<repeated_tag *>(),
+            std::declval<std::string &>(),
+            std::declval<detail::nope &>(),
+            std::declval<tuple<int> const &>()));
+        static_assert(!detail::memo_uses_rule_params_v<
+                      decltype(pair)::parser_type,
+                      context_t>);
+        static_assert(
+            detail::memo_uses_rule_params_v<param_rule_t, context_t>);
+        static_assert(detail::memo_uses_rule_params_v<
+                      decltype(pair)::parser_type,
+                      param_context_t>);
+    }
+}
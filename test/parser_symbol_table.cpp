@@ -4,6 +4,7 @@
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 #include <boost/parser/parser.hpp>
+#include <boost/parser/transcode_view.hpp>
 
 #include <gtest/gtest.h>
 
@@ -160,3 +161,232 @@ TEST(parser, symbols_mutating)
         EXPECT_FALSE(result);
     }
 }
+
+TEST(parser, symbols_shared_between_parses)
+{
+    symbols<int> roman_numerals = {{"I", 1}, {"V", 5}, {"X", 10}};
+    auto const erase_numeral = [&roman_numerals](auto & context) {
+        char chars[2] = {_attr(context), 0};
+        roman_numerals.erase(context, chars);
+    };
+    auto const erasing_parser = char_[erase_numeral] >> roman_numerals;
+    auto const copy = roman_numerals;
+
+    {
+        auto const result = parse("VV", erasing_parser);
+        EXPECT_FALSE(result);
+        EXPECT_TRUE(parse("V", roman_numerals));
+        EXPECT_TRUE(parse("V", copy));
+    }
+    {
+        auto const result = parse("VX", erasing_parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 10);
+    }
+
+    roman_numerals.insert_for_next_parse("L", 50);
+    {
+        auto const result = parse("L", copy);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 50);
+    }
+    {
+        auto const result = parse("XL", erasing_parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 50);
+    }
+}
+
+TEST(parser, symbols_insert_for_next_parse_in_action)
+{
+    symbols<int> table = {{"a", 1}};
+    // The table keeps only a view of each string it is given.
+    std::string_view const letters = "abcdefghijklmnopqrstuvwxyz";
+    auto const add_symbol = [&](auto & context) {
+        table.insert_for_next_parse(letters.substr(_attr(context) - 'a', 1), 2);
+    };
+    auto const parser = +(table | char_('b', 'z')[add_symbol]);
+
+    {
+        auto const result = parse("abba", parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<std::optional<int>>({1, 1}));
+    }
+    {
+        auto const result = parse("bac", parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, std::vector<std::optional<int>>({2, 1}));
+        EXPECT_TRUE(parse("c", table));
+    }
+    {
+        // The first lookup comes after the insertion.
+        auto const result = parse("dd", char_[add_symbol] >> table);
+        EXPECT_FALSE(result);
+        EXPECT_TRUE(parse("d", table));
+    }
+}
+
+TEST(parser, symbols_large_table)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back("key" + std::to_string(i));
+    }
+    symbols<int> table;
+    for (int i = 0; i < 1000; ++i) {
+        table.insert_for_next_parse(keys[i], i);
+    }
+    table.insert_for_next_parse("key7", -7);
+    table.insert_for_next_parse("\xc3\xa9t\xc3\xa9", 2000);
+    table.insert_for_next_parse("\xc3\xa9", 2001);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto const result = parse(keys[i], table);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, i);
+    }
+    {
+        auto const result = parse(keys[123] + "4x", table);
+        EXPECT_FALSE(result);
+    }
+    {
+        std::string const str = keys[123] + "x";
+        auto first = str.begin();
+        auto const result = prefix_parse(first, str.end(), table);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 123);
+        EXPECT_EQ(*first, 'x');
+    }
+    {
+        auto const result = parse("\xc3\xa9t\xc3\xa9" | as_utf32, table);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 2000);
+    }
+    {
+        auto const result = parse("\xc3\xa9" | as_utf32, table);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 2001);
+    }
+    EXPECT_FALSE(parse("ke", table));
+    EXPECT_FALSE(parse("", table));
+}
+
+TEST(parser, symbols_no_case)
+{
+    symbols<int> table = {
+        {"select", 1},
+        {"Foo", 2},
+        {"FOO", 3},
+        {"s", 4},
+        {"stra\xc3\x9f" "e", 5},
+        {"\xc3\xa9t\xc3\xa9", 6}};
+
+    {
+        auto const result = parse("SeLeCt", no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 1);
+        EXPECT_FALSE(parse("SeLeCt", table));
+    }
+    {
+        // Keys that differ only in case are the same key under no_case[];
+        // the first one inserted is used.
+        auto const result = parse("foo", no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 2);
+        EXPECT_EQ(*parse("FOO", table), 3);
+    }
+    {
+        auto const result = parse("STRASSE" | as_utf32, no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 5);
+    }
+    {
+        auto const result =
+            parse("\xc3\x89T\xc3\x89" | as_utf32, no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 6);
+    }
+    {
+        // U+00DF folds to "ss"; "s" matches only part of its folding.
+        auto const result = parse("\xc3\x9f" | as_utf32, no_case[table]);
+        EXPECT_FALSE(result);
+    }
+    {
+        std::string const str = "SX";
+        auto first = str.begin();
+        auto const result = prefix_parse(first, str.end(), no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 4);
+        EXPECT_EQ(*first, 'X');
+    }
+
+    auto const add = [&table](auto & context) {
+        using namespace boost::parser::literals;
+        table.insert(
+            context, get(_attr(context), 0_c), get(_attr(context), 1_c));
+    };
+    auto const erase = [&table](auto & context) {
+        table.erase(context, _attr(context));
+    };
+    auto const word = +lower;
+    auto const adding_parser =
+        (word >> ':' >> int_)[add] >> ' ' >> no_case[table];
+    auto const erasing_parser = ('-' >> word)[erase] >> ' ' >> no_case[table];
+    {
+        auto const result = parse("where:7 WHERE", adding_parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 7);
+        EXPECT_FALSE(parse("WHERE", no_case[table]));
+    }
+    {
+        auto const result = parse("select:7 SELECT", adding_parser);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 1);
+    }
+    {
+        auto const result = parse("-select SELECT", erasing_parser);
+        EXPECT_FALSE(result);
+    }
+    {
+        // The mutation happens before the first no_case[] lookup of the
+        // parse, and after it.
+        auto const result = parse(
+            "where:7 SELECT -select WHERE",
+            (word >> ':' >> int_)[add] >> ' ' >> no_case[table] >> ' ' >>
+                ('-' >> word)[erase] >> ' ' >> no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, (tuple<int, int>(1, 7)));
+    }
+
+    // Erasing one of several keys that differ only in case leaves the
+    // others matching under no_case[].
+    auto const erase_foo = [&table](auto & context) {
+        table.erase(context, "Foo");
+    };
+    auto const insert_bar = [&table](auto & context) {
+        table.insert(context, "bar", 8);
+    };
+    {
+        auto const result = parse("foo", eps[erase_foo] >> no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, 3);
+    }
+    {
+        // The case folded table has already been built when "Foo" is
+        // erased.
+        auto const result = parse(
+            "foo foo",
+            eps[insert_bar] >> no_case[table] >> ' ' >> eps[erase_foo] >>
+                no_case[table]);
+        EXPECT_TRUE(result);
+        EXPECT_EQ(*result, (tuple<int, int>(2, 3)));
+    }
+    {
+        auto const result = parse(
+            "foo",
+            eps[erase_foo] >> eps[([&table](auto & context) {
+                table.erase(context, "FOO");
+            })] >> no_case[table]);
+        EXPECT_FALSE(result);
+    }
+}
@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 
 namespace bp = boost::parser;
 
@@ -730,6 +732,170 @@ TEST(search, search_all_unicode)
     }
 }
 
+namespace {
+    // Searching a std::string uses a prefilter, when the parser allows it.
+    // Searching through as_utf32 does not, so the results must agree.
+    template<typename Parser>
+    void check_prefilter(
+        std::string const & str, Parser const & parser, bool all = true)
+    {
+        auto const result = bp::search(str, parser);
+        auto const r32 = str | bp::as_utf32;
+        auto const result32 = bp::search(r32, parser);
+        EXPECT_EQ(
+            result.begin() - str.begin(),
+            std::distance(str.begin(), result32.begin().base()))
+            << '"' << str << '"';
+        EXPECT_EQ(
+            result.end() - str.begin(),
+            std::distance(str.begin(), result32.end().base()))
+            << '"' << str << '"';
+        if (!all)
+            return;
+
+        int count = 0;
+        int count32 = 0;
+        for (auto subrange : str | bp::search_all(parser)) {
+            (void)subrange;
+            ++count;
+        }
+        for (auto subrange : r32 | bp::search_all(parser)) {
+            (void)subrange;
+            ++count32;
+        }
+        EXPECT_EQ(count, count32) << '"' << str << '"';
+    }
+}
+
+TEST(search, prefilter)
+{
+    bp::symbols<int> const sym = {{"ab", 1}, {"ba", 2}, {"abc", 3}};
+    std::string const inputs[] = {
+        "",
+        "a",
+        "ab",
+        "xxabcx",
+        "abababab",
+        "[1,2] [3]",
+        "x=ab=ba",
+        "abcabd",
+        "cab[12,x]",
+    };
+    for (auto const & str : inputs) {
+        check_prefilter(str, bp::lit("ab"));
+        check_prefilter(str, bp::lit('b'));
+        check_prefilter(str, bp::char_("b]"));
+        check_prefilter(str, bp::string("abc") | bp::string("ab"));
+        check_prefilter(str, bp::char_('a', 'b') >> bp::char_('c'));
+        check_prefilter(str, bp::lit("ab") >> -bp::lit('d'));
+        check_prefilter(str, '[' >> bp::int_ % ',' >> ']');
+        check_prefilter(str, +bp::char_('b'));
+        check_prefilter(str, sym);
+        check_prefilter(str, bp::raw[sym >> '=']);
+        // These have no prefilter.  (The first one can match the empty
+        // string, so it cannot be used with search_all.)
+        check_prefilter(str, *bp::char_('b'), false);
+        check_prefilter(str, bp::no_case[bp::lit("AB")]);
+    }
+
+    {
+        // A match longer than the prefix that must begin it.
+        std::string const str = "ab abd abdd";
+        auto const result = bp::search(str, bp::lit("ab") >> bp::lit("dd"));
+        EXPECT_EQ(result.begin() - str.begin(), 7);
+        EXPECT_EQ(result.end() - str.begin(), 11);
+    }
+
+    {
+        // An expectation failure ends the search, and is reported once,
+        // relative to the whole input.
+        std::string const str = "xx ab a1";
+        auto const parser = bp::lit('a') > bp::digit;
+        std::stringstream err;
+        std::streambuf * const cerr_buf = std::cerr.rdbuf(err.rdbuf());
+        auto const result = bp::search(str, parser);
+        std::string const message = err.str();
+        err.str("");
+        auto const result32 = bp::search(str | bp::as_utf32, parser);
+        std::cerr.rdbuf(cerr_buf);
+        EXPECT_EQ(
+            message, "1:4: error: Expected digit here:\nxx ab a1\n    ^\n");
+        EXPECT_EQ(message, err.str());
+        EXPECT_EQ(result.begin(), str.begin());
+        EXPECT_EQ(result.end(), str.begin());
+        EXPECT_EQ(result32.begin().base(), str.begin());
+        EXPECT_EQ(result32.end().base(), str.begin());
+    }
+}
+
+namespace {
+    template<typename Parser>
+    std::vector<std::pair<long, long>>
+    all_matches(std::string const & str, Parser const & parser)
+    {
+        std::vector<std::pair<long, long>> retval;
+        for (auto subrange : str | bp::search_all(parser)) {
+            retval.emplace_back(
+                subrange.begin() - str.begin(), subrange.end() - str.begin());
+        }
+        return retval;
+    }
+
+    template<typename Parser>
+    std::vector<std::pair<long, long>>
+    all_matches_utf32(std::string const & str, Parser const & parser)
+    {
+        std::vector<std::pair<long, long>> retval;
+        for (auto subrange : str | bp::as_utf32 | bp::search_all(parser)) {
+            retval.emplace_back(
+                std::distance(str.begin(), subrange.begin().base()),
+                std::distance(str.begin(), subrange.end().base()));
+        }
+        return retval;
+    }
+}
+
+TEST(search, aho_corasick)
+{
+    // Overlapping symbols, some of which are prefixes or suffixes of others.
+    bp::symbols<int> const sym = {
+        {"a", 0},
+        {"ab", 1},
+        {"bab", 2},
+        {"abba", 3},
+        {"babb", 4},
+        {"bbbbbb", 5},
+        {"ca", 6},
+        {"acab", 7}};
+    auto const literals = bp::string("ab") | bp::string("bab") |
+                          bp::string("abba") | bp::lit("cab") | bp::char_('c');
+    auto const literals_seq = (bp::string("bab") | bp::string("abb")) >> 'c';
+
+    uint64_t x = 42;
+    for (int i = 0; i < 2000; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        std::string str((x >> 33) % 40, ' ');
+        for (auto & c : str) {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+            c = "abbc "[(x >> 33) % 5];
+        }
+        EXPECT_EQ(all_matches(str, sym), all_matches_utf32(str, sym)) << str;
+        EXPECT_EQ(all_matches(str, literals), all_matches_utf32(str, literals))
+            << str;
+        EXPECT_EQ(
+            all_matches(str, literals_seq),
+            all_matches_utf32(str, literals_seq))
+            << str;
+    }
+
+    {
+        std::string const str = "xx babbbbbbb abbab acab";
+        using matches = std::vector<std::pair<long, long>>;
+        EXPECT_EQ(
+            all_matches(str, sym), matches({{3, 7}, {13, 17}, {19, 23}}));
+    }
+}
+
 TEST(search, doc_examples)
 {
     {
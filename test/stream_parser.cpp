@@ -0,0 +1,146 @@
+/**
+ *   Copyright (C) 2024 T. Zachary Laine
+ *
+ *   Distributed under the Boost Software License, Version 1.0. (See
+ *   accompanying file LICENSE_1_0.txt or copy at
+ *   http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <boost/parser/stream_parser.hpp>
+
+#include <gtest/gtest.h>
+
+
+namespace bp = boost::parser;
+
+namespace {
+    auto const record = *(bp::char_ - ',') >> ',' >> bp::int_ >> bp::eol;
+    using record_type = bp::tuple<std::string, int>;
+
+    std::string const records = "abc,1\nde,-22\n,333\nfghijklmnop,4\n";
+
+    std::vector<record_type> expected_records()
+    {
+        auto const result = bp::parse(records, *record);
+        return result ? *result : std::vector<record_type>();
+    }
+}
+
+TEST(stream_parser, chunked_records)
+{
+    auto const expected = expected_records();
+    EXPECT_EQ(expected.size(), 4u);
+
+    for (std::size_t chunk_size = 1; chunk_size <= records.size() + 1;
+         ++chunk_size) {
+        std::vector<record_type> result;
+        auto sp = bp::make_stream_parser(
+            record, [&](record_type r) { result.push_back(std::move(r)); });
+        std::string_view const input = records;
+        for (std::size_t i = 0; i < input.size(); i += chunk_size) {
+            EXPECT_TRUE(sp.feed(input.substr(i, chunk_size)));
+            // Nothing is kept but the record in progress, and the longest
+            // record is 14 chars.
+            EXPECT_TRUE(sp.unparsed().size() <= 14u);
+        }
+        EXPECT_TRUE(sp.finish());
+        EXPECT_TRUE(sp.unparsed().empty());
+        EXPECT_EQ(result, expected) << "chunk_size=" << chunk_size;
+    }
+}
+
+TEST(stream_parser, records_complete_only_when_followed_by_input)
+{
+    std::vector<int> result;
+    auto sp = bp::make_stream_parser(
+        bp::int_ >> -bp::lit(';'), [&](int x) { result.push_back(x); });
+
+    // "12" might be the start of "123".
+    EXPECT_TRUE(sp.feed("12"));
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(sp.unparsed(), "12");
+
+    EXPECT_TRUE(sp.feed("3;4"));
+    EXPECT_EQ(result, std::vector<int>({123}));
+    EXPECT_EQ(sp.unparsed(), "4");
+
+    EXPECT_TRUE(sp.finish());
+    EXPECT_EQ(result, std::vector<int>({123, 4}));
+}
+
+TEST(stream_parser, skipper)
+{
+    std::vector<int> result;
+    auto sp = bp::make_stream_parser(
+        bp::int_ >> ';', bp::ws, [&](int x) { result.push_back(x); });
+
+    EXPECT_TRUE(sp.feed(" 1 ; 2;\n"));
+    EXPECT_TRUE(sp.feed("  3 ;"));
+    EXPECT_TRUE(sp.feed("\n\n  "));
+    EXPECT_TRUE(sp.finish());
+    EXPECT_EQ(result, std::vector<int>({1, 2, 3}));
+    EXPECT_TRUE(sp.unparsed().empty());
+
+    // After finish(), a new sequence of records can be fed.
+    EXPECT_TRUE(sp.feed("4"));
+    EXPECT_TRUE(sp.feed(";"));
+    EXPECT_TRUE(sp.finish());
+    EXPECT_EQ(result, std::vector<int>({1, 2, 3, 4}));
+}
+
+TEST(stream_parser, no_attribute)
+{
+    int count = 0;
+    auto sp = bp::make_stream_parser(
+        bp::omit[+bp::lower] >> bp::eol, [&] { ++count; });
+    EXPECT_TRUE(sp.feed("ab\ncd"));
+    EXPECT_EQ(count, 1);
+    EXPECT_TRUE(sp.feed("e\nf\n"));
+    EXPECT_EQ(count, 3);
+    EXPECT_TRUE(sp.finish());
+    EXPECT_EQ(count, 3);
+}
+
+TEST(stream_parser, errors)
+{
+    std::vector<std::string> errors;
+    bp::callback_error_handler error_handler(
+        [&](std::string const & msg) { errors.push_back(msg); });
+
+    std::vector<int> result;
+    auto const parser =
+        bp::with_error_handler(bp::int_ > ';', error_handler);
+    auto sp = bp::make_stream_parser(
+        parser, bp::ws, [&](int x) { result.push_back(x); });
+
+    // The missing ';' might still arrive, so this is not an error yet.
+    EXPECT_TRUE(sp.feed("1; 2"));
+    EXPECT_EQ(result, std::vector<int>({1}));
+    EXPECT_TRUE(errors.empty());
+
+    EXPECT_FALSE(sp.feed(" x; 3;"));
+    EXPECT_EQ(result, std::vector<int>({1}));
+    EXPECT_EQ(errors.size(), 1u);
+    EXPECT_TRUE(sp.failed());
+    EXPECT_EQ(sp.unparsed(), "2 x; 3;");
+
+    // Input is kept, but not parsed, until the bad record is discarded.
+    EXPECT_FALSE(sp.feed(" 4;"));
+    EXPECT_EQ(result, std::vector<int>({1}));
+    EXPECT_EQ(errors.size(), 1u);
+
+    sp.discard(4);
+    EXPECT_FALSE(sp.failed());
+    EXPECT_TRUE(sp.feed(""));
+    EXPECT_EQ(result, std::vector<int>({1, 3}));
+    EXPECT_TRUE(sp.finish());
+    EXPECT_EQ(result, std::vector<int>({1, 3, 4}));
+    EXPECT_EQ(errors.size(), 1u);
+
+    // At the end of the input, an incomplete record is an error.
+    EXPECT_TRUE(sp.feed("5"));
+    EXPECT_EQ(errors.size(), 1u);
+    EXPECT_FALSE(sp.finish());
+    EXPECT_EQ(errors.size(), 2u);
+    EXPECT_EQ(sp.unparsed(), "5");
+}
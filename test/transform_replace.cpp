@@ -835,6 +835,36 @@ TEST(transform_replace, join_compat)
 }
 #endif
 
+TEST(transform_replace, symbols)
+{
+    bp::symbols<int> const sym = {
+        {"ab", 1}, {"bab", 2}, {"abba", 3}, {"ca", 4}};
+    auto f = [](int x) { return std::string(1, char('0' + x)); };
+    {
+        std::string str = "xbabba abbab cab";
+        std::string result;
+        for (auto subrange : str | bp::transform_replace(sym, f)) {
+            for (auto ch : subrange) {
+                result.push_back(ch);
+            }
+        }
+        EXPECT_EQ(result, "x2ba 3b 4b");
+    }
+    {
+        auto const literals = bp::string("ab") | bp::string("bab") |
+                              bp::string("abba") | bp::string("ca");
+        auto g = [](std::string const & s) { return "<" + s + ">"; };
+        std::string str = "xbabba abbab cab";
+        std::string result;
+        for (auto subrange : str | bp::transform_replace(literals, g)) {
+            for (auto ch : subrange) {
+                result.push_back(ch);
+            }
+        }
+        EXPECT_EQ(result, "x<bab>ba <ab><bab> <ca>b");
+    }
+}
+
 TEST(transform_replace, doc_examples)
 {
     {